@@ -0,0 +1,345 @@
+// Headless bench for the TTL panels' hot paths.
+// Builds the real panel sources against the stand-ins in StandIns/, and drives them with synthetic loads.
+//
+// Usage: ttl-panels-bench [--quick] [--seconds N]
+//
+// For each load it prints:
+//   ns/block      time in process(), per block
+//   ns/event      time in process(), per event handled (display) or emitted (toggle)
+//   allocs/block  heap allocations made inside process(), per block, including the events the plugin creates
+//   allocs/event  the same, per event
+// The toggle-word rows also time each ttl_word change through setParameter() and parameterValueChanged(),
+// as the message thread would make it.
+
+#include "../Source/FrontPanel.h"
+#include "../Source/TogglePanel.h"
+#include "StandIns.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+using namespace TTLDebugTools;
+
+//
+// Allocation counter. Every operator new in the process goes through here.
+
+static std::atomic<uint64> allocationCount { 0 };
+
+void* operator new (size_t size)
+{
+    allocationCount.fetch_add (1, std::memory_order_relaxed);
+
+    if (void* block = std::malloc (size == 0 ? 1 : size))
+        return block;
+
+    throw std::bad_alloc();
+}
+
+void* operator new[] (size_t size)
+{
+    return operator new (size);
+}
+
+void operator delete (void* block) noexcept
+{
+    std::free (block);
+}
+
+void operator delete[] (void* block) noexcept
+{
+    std::free (block);
+}
+
+void operator delete (void* block, size_t) noexcept
+{
+    std::free (block);
+}
+
+void operator delete[] (void* block, size_t) noexcept
+{
+    std::free (block);
+}
+
+//
+// Loads.
+
+#define BENCH_SAMPLE_RATE 30000.0f
+#define BENCH_LINES 8
+
+enum Scenario
+{
+    // TTLFrontPanel: input events through checkForEvents() and handleTTLEvent().
+    DisplayInput = 0,
+
+    // TTLTogglePanel: word changes through setParameter(), emitted by process().
+    ToggleWord,
+
+    // TTLTogglePanel: the load generator's edges, emitted by process().
+    ToggleLoad
+};
+
+static const char* scenarioNames[] = { "display-input", "toggle-word", "toggle-load" };
+
+struct Load
+{
+    Scenario scenario;
+    int numStreams;
+    double eventsPerSecond;
+    int blockSamples;
+};
+
+struct Measurement
+{
+    uint64 blocks = 0;
+    uint64 events = 0;
+    int64 processTicks = 0;
+    uint64 processAllocations = 0;
+
+    uint64 changes = 0;
+    int64 changeTicks = 0;
+    uint64 changeAllocations = 0;
+};
+
+// Spreads a fractional number of events per block over the blocks, so the long-run rate is exact.
+class EventPacer
+{
+public:
+    EventPacer (double eventsPerBlock_) : eventsPerBlock (eventsPerBlock_) {}
+
+    int next()
+    {
+        owed += eventsPerBlock;
+        const int count = int (owed);
+        owed -= count;
+        return count;
+    }
+
+private:
+    double eventsPerBlock;
+    double owed = 0.0;
+};
+
+static uint64 countAllocations()
+{
+    return allocationCount.load (std::memory_order_relaxed);
+}
+
+// Runs "numBlocks" blocks, and only measures them if "measurement" isn't null.
+static void runBlocks (TTLPanelBase& panel, const Load& load, int64& firstSample, std::vector<EventPacer>& pacers,
+                       const std::vector<var>& words, size_t& nextWord, int numBlocks, Measurement* measurement)
+{
+    AudioBuffer<float> buffer (1, load.blockSamples);
+    std::vector<bool> levels (size_t (load.numStreams * BENCH_LINES), false);
+    std::vector<int> nextLine (size_t (load.numStreams), 0);
+
+    panel.inputEvents.reserve (size_t (load.numStreams) * size_t (load.blockSamples));
+
+    for (int block = 0; block < numBlocks; block++)
+    {
+        panel.setBlock (firstSample, uint32 (load.blockSamples));
+        panel.inputEvents.clear();
+
+        if (load.scenario == DisplayInput)
+        {
+            // Built before the clock starts; these belong to the upstream processor.
+            for (int stream = 0; stream < load.numStreams; stream++)
+            {
+                const int count = pacers[size_t (stream)].next();
+
+                for (int index = 0; index < count; index++)
+                {
+                    const int line = nextLine[size_t (stream)];
+                    const size_t levelIndex = size_t (stream * BENCH_LINES + line);
+                    levels[levelIndex] = ! levels[levelIndex];
+                    nextLine[size_t (stream)] = (line + 1) % BENCH_LINES;
+
+                    const int64 sampleNumber = firstSample + int64 (index) * load.blockSamples / count;
+                    panel.inputEvents.push_back (std::make_shared<TTLEvent> (uint16 (stream + 1), sampleNumber, uint8 (line), levels[levelIndex]));
+                }
+            }
+        }
+        else if (load.scenario == ToggleWord)
+        {
+            // The message thread's share: one parameter change per word change.
+            const uint64 allocationsBefore = countAllocations();
+            const int64 startTicks = Time::getHighResolutionTicks();
+            uint64 changes = 0;
+
+            for (auto stream : panel.getDataStreams())
+            {
+                Parameter* wordParam = stream->getParameter ("ttl_word");
+                const int count = pacers[size_t (stream->getStreamId() - 1)].next();
+
+                for (int index = 0; index < count; index++)
+                {
+                    wordParam->setNextValue (words[nextWord], false);
+                    nextWord = (nextWord + 1) % words.size();
+                }
+
+                changes += uint64 (count);
+            }
+
+            if (measurement != nullptr)
+            {
+                measurement->changeTicks += Time::getHighResolutionTicks() - startTicks;
+                measurement->changeAllocations += countAllocations() - allocationsBefore;
+                measurement->changes += changes;
+            }
+        }
+
+        const uint64 eventsBefore = panel.eventsAdded;
+        const uint64 allocationsBefore = countAllocations();
+        const int64 startTicks = Time::getHighResolutionTicks();
+
+        panel.process (buffer);
+
+        const int64 endTicks = Time::getHighResolutionTicks();
+        const uint64 allocations = countAllocations() - allocationsBefore;
+
+        if (measurement != nullptr)
+        {
+            measurement->blocks++;
+            measurement->processTicks += endTicks - startTicks;
+            measurement->processAllocations += allocations;
+            measurement->events += load.scenario == DisplayInput ? uint64 (panel.inputEvents.size()) : panel.eventsAdded - eventsBefore;
+        }
+
+        firstSample += load.blockSamples;
+    }
+}
+
+static Measurement runLoad (const Load& load, double seconds)
+{
+    std::unique_ptr<TTLPanelBase> panel;
+
+    if (load.scenario == DisplayInput)
+        panel = std::make_unique<TTLFrontPanel>();
+    else
+        panel = std::make_unique<TTLTogglePanel>();
+
+    panel->registerParameters();
+    panel->setUpStreams (load.numStreams, BENCH_SAMPLE_RATE);
+
+    if (load.scenario == ToggleLoad && load.eventsPerSecond > 0.0)
+    {
+        panel->getParameter ("load_mode")->setNextValue (var (1));
+        panel->getParameter ("load_lines")->setNextValue (var (BENCH_LINES));
+        panel->getParameter ("load_streams")->setNextValue (var (load.numStreams));
+        panel->getParameter ("load_rate")->setNextValue (var (load.eventsPerSecond / BENCH_LINES));
+    }
+
+    // Parameter values are built up front, as the editor would have built them before the change.
+    std::vector<var> words;
+
+    for (int index = 0; index < 256; index++)
+        words.push_back (var (TTLPanelBase::wordToParameterValue (uint64 (index) * 0x0101010101010101ULL)));
+
+    std::vector<EventPacer> pacers (size_t (load.numStreams), EventPacer (load.eventsPerSecond * load.blockSamples / BENCH_SAMPLE_RATE));
+    size_t nextWord = 1;
+    int64 firstSample = 0;
+
+    TTLDebugBench::acquisitionActive = true;
+    panel->startAcquisition();
+
+    // Warm up, so the first blocks don't pay for cold caches.
+    runBlocks (*panel, load, firstSample, pacers, words, nextWord, 16, nullptr);
+
+    Measurement measurement;
+    const int numBlocks = jmax (1, int (seconds * BENCH_SAMPLE_RATE / load.blockSamples));
+    runBlocks (*panel, load, firstSample, pacers, words, nextWord, numBlocks, &measurement);
+
+    panel->stopAcquisition();
+    TTLDebugBench::acquisitionActive = false;
+
+    return measurement;
+}
+
+static void printMeasurement (const Load& load, const Measurement& measurement)
+{
+    const double blockNs = double (measurement.processTicks) / double (measurement.blocks);
+    const double allocationsPerBlock = double (measurement.processAllocations) / double (measurement.blocks);
+
+    char eventNs[32] = "-";
+    char eventAllocations[32] = "-";
+
+    if (measurement.events > 0)
+    {
+        std::snprintf (eventNs, sizeof (eventNs), "%.1f", double (measurement.processTicks) / double (measurement.events));
+        std::snprintf (eventAllocations, sizeof (eventAllocations), "%.2f", double (measurement.processAllocations) / double (measurement.events));
+    }
+
+    char changeNs[32] = "-";
+    char changeAllocations[32] = "-";
+
+    if (measurement.changes > 0)
+    {
+        std::snprintf (changeNs, sizeof (changeNs), "%.1f", double (measurement.changeTicks) / double (measurement.changes));
+        std::snprintf (changeAllocations, sizeof (changeAllocations), "%.2f", double (measurement.changeAllocations) / double (measurement.changes));
+    }
+
+    std::printf ("%-14s %7d %9.0f %6d %12.0f %9s %12.2f %12s %10s %13s\n",
+                 scenarioNames[load.scenario],
+                 load.numStreams,
+                 load.eventsPerSecond,
+                 load.blockSamples,
+                 blockNs,
+                 eventNs,
+                 allocationsPerBlock,
+                 eventAllocations,
+                 changeNs,
+                 changeAllocations);
+}
+
+int main (int argc, char* argv[])
+{
+    bool quick = false;
+    double seconds = 2.0;
+
+    for (int arg = 1; arg < argc; arg++)
+    {
+        if (std::strcmp (argv[arg], "--quick") == 0)
+        {
+            quick = true;
+            seconds = 0.25;
+        }
+        else if (std::strcmp (argv[arg], "--seconds") == 0 && arg + 1 < argc)
+        {
+            seconds = jmax (0.01, std::atof (argv[++arg]));
+        }
+        else
+        {
+            std::fprintf (stderr, "usage: %s [--quick] [--seconds N]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    const std::vector<int> streamCounts = quick ? std::vector<int> { 1, 8 } : std::vector<int> { 1, 2, 4, 8 };
+    const std::vector<double> rates = quick ? std::vector<double> { 0.0, 100000.0 } : std::vector<double> { 0.0, 1000.0, 10000.0, 100000.0 };
+    const std::vector<int> blockSizes = quick ? std::vector<int> { 64, 4096 } : std::vector<int> { 64, 256, 1024, 4096 };
+
+    std::printf ("%.2f s of %.0f Hz data per load; rates are events/s per stream\n\n", seconds, double (BENCH_SAMPLE_RATE));
+    std::printf ("%-14s %7s %9s %6s %12s %9s %12s %12s %10s %13s\n",
+                 "load", "streams", "events/s", "block", "ns/block", "ns/event", "allocs/block", "allocs/event", "ns/change", "allocs/change");
+
+    for (Scenario scenario : { DisplayInput, ToggleWord, ToggleLoad })
+    {
+        for (int numStreams : streamCounts)
+        {
+            for (double rate : rates)
+            {
+                for (int blockSamples : blockSizes)
+                {
+                    const Load load { scenario, numStreams, rate, blockSamples };
+                    printMeasurement (load, runLoad (load, seconds));
+                }
+            }
+        }
+    }
+
+    return 0;
+}
+
+// This is the end of the file.
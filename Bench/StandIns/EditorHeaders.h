@@ -0,0 +1,456 @@
+#ifndef TTLDEBUGBENCHEDITORHEADERS_H_DEFINED
+#define TTLDEBUGBENCHEDITORHEADERS_H_DEFINED
+
+// Stand-ins for the JUCE and Open Ephys GUI classes. The bench never opens an editor,
+// so these only have to compile and link; none of them draw or hold state.
+
+#include "ProcessorHeaders.h"
+
+class Colour
+{
+public:
+    Colour() = default;
+    Colour (int, int, int) {}
+    Colour (uint32) {}
+    Colour withAlpha (float) const { return *this; }
+    Colour darker (float = 0.4f) const { return *this; }
+    Colour brighter (float = 0.4f) const { return *this; }
+    Colour interpolatedWith (Colour, float) const { return *this; }
+};
+
+namespace juce
+{
+namespace Colours
+{
+    extern const Colour transparentWhite, grey, lime, black, white, red, yellow, darkgrey, orange;
+} // namespace Colours
+} // namespace juce
+
+namespace ThemeColours
+{
+enum
+{
+    widgetBackground,
+    defaultText,
+    componentBackground,
+    componentParentBackground,
+    outline,
+    highlightedFill,
+    defaultFill
+};
+} // namespace ThemeColours
+
+class Justification
+{
+public:
+    enum
+    {
+        centred,
+        left,
+        right,
+        centredLeft,
+        centredRight
+    };
+
+    Justification (int) {}
+};
+
+enum NotificationType
+{
+    dontSendNotification,
+    sendNotification,
+    sendNotificationSync,
+    sendNotificationAsync
+};
+
+template <typename ValueType>
+class Point
+{
+public:
+    Point() = default;
+    Point (ValueType x_, ValueType y_) : x (x_), y (y_) {}
+    ValueType getX() const { return x; }
+    ValueType getY() const { return y; }
+
+    ValueType x {};
+    ValueType y {};
+};
+
+template <typename ValueType>
+class Rectangle
+{
+public:
+    Rectangle() = default;
+    Rectangle (ValueType, ValueType) {}
+    Rectangle (ValueType, ValueType, ValueType, ValueType) {}
+
+    ValueType getX() const { return 0; }
+    ValueType getY() const { return 0; }
+    ValueType getWidth() const { return 0; }
+    ValueType getHeight() const { return 0; }
+    ValueType getRight() const { return 0; }
+    ValueType getBottom() const { return 0; }
+    bool isEmpty() const { return true; }
+    bool contains (ValueType, ValueType) const { return false; }
+    bool intersects (const Rectangle&) const { return false; }
+    Rectangle expanded (ValueType, ValueType) const { return *this; }
+    Rectangle reduced (ValueType) const { return *this; }
+    Rectangle withWidth (ValueType) const { return *this; }
+    Rectangle getUnion (const Rectangle&) const { return *this; }
+    Rectangle removeFromLeft (ValueType) { return *this; }
+    Rectangle removeFromTop (ValueType) { return *this; }
+    Rectangle<float> toFloat() const { return {}; }
+    Rectangle<int> getSmallestIntegerContainer() const { return {}; }
+};
+
+class FontOptions
+{
+public:
+    FontOptions (const char*, const char*, float) {}
+    FontOptions (float) {}
+};
+
+class Image
+{
+public:
+    enum PixelFormat
+    {
+        ARGB,
+        RGB
+    };
+
+    class BitmapData
+    {
+    public:
+        enum ReadWriteMode
+        {
+            readOnly,
+            writeOnly,
+            readWrite
+        };
+
+        BitmapData (Image&, ReadWriteMode) {}
+        void setPixelColour (int, int, Colour) {}
+
+        int width = 0;
+        int height = 0;
+    };
+
+    Image() = default;
+    Image (PixelFormat, int, int, bool) {}
+
+    bool isValid() const { return false; }
+    int getWidth() const { return 0; }
+    int getHeight() const { return 0; }
+    Rectangle<int> getBounds() const { return {}; }
+    void clear (const Rectangle<int>&, Colour = Colour()) {}
+};
+
+class Path
+{
+public:
+    void startNewSubPath (float, float) {}
+    void lineTo (float, float) {}
+    void clear() {}
+};
+
+class PathStrokeType
+{
+public:
+    PathStrokeType (float) {}
+};
+
+class Graphics
+{
+public:
+    Graphics() = default;
+    Graphics (Image&) {}
+
+    void setColour (Colour) {}
+    void setFont (float) {}
+    void setFont (FontOptions) {}
+    void setOpacity (float) {}
+    void fillAll() {}
+    void fillAll (Colour) {}
+    void fillRect (int, int, int, int) {}
+    void fillRect (float, float, float, float) {}
+    void fillRect (Rectangle<int>) {}
+    void fillRect (Rectangle<float>) {}
+    void drawRect (int, int, int, int, int = 1) {}
+    void drawRect (Rectangle<int>, int = 1) {}
+    void drawRect (Rectangle<float>, float = 1.0f) {}
+    void drawText (const String&, Rectangle<float>, Justification, bool = true) {}
+    void drawText (const String&, Rectangle<int>, Justification, bool = true) {}
+    void drawText (const String&, int, int, int, int, Justification, bool = true) {}
+    void drawLine (float, float, float, float, float = 1.0f) {}
+    void drawVerticalLine (int, float, float) {}
+    void drawHorizontalLine (int, float, float) {}
+    void drawImage (const Image&, int, int, int, int, int, int, int, int, bool = false) {}
+    void drawImageAt (const Image&, int, int, bool = false) {}
+    void strokePath (const Path&, const PathStrokeType&) {}
+    Rectangle<int> getClipBounds() const { return {}; }
+    void reduceClipRegion (Rectangle<int>) {}
+    bool clipRegionIntersects (Rectangle<int>) const { return false; }
+    void saveState() {}
+    void restoreState() {}
+};
+
+class MouseEvent
+{
+public:
+    Point<int> getPosition() const { return {}; }
+
+    int x = 0;
+    int y = 0;
+};
+
+class TooltipClient
+{
+public:
+    virtual ~TooltipClient() = default;
+    virtual String getTooltip() = 0;
+};
+
+class Component
+{
+public:
+    Component() = default;
+    Component (const String&) {}
+    virtual ~Component() = default;
+
+    virtual void paint (Graphics&) {}
+    virtual void resized() {}
+    virtual void lookAndFeelChanged() {}
+    virtual void mouseDown (const MouseEvent&) {}
+    virtual void mouseUp (const MouseEvent&) {}
+    virtual void mouseMove (const MouseEvent&) {}
+    virtual void mouseExit (const MouseEvent&) {}
+
+    void setBounds (int, int, int, int) {}
+    void setBounds (Rectangle<int>) {}
+    void setSize (int, int) {}
+    int getX() const { return 0; }
+    int getY() const { return 0; }
+    int getWidth() const { return 0; }
+    int getHeight() const { return 0; }
+    int getRight() const { return 0; }
+    int getBottom() const { return 0; }
+    Rectangle<int> getLocalBounds() const { return {}; }
+    Rectangle<int> getScreenBounds() const { return {}; }
+    Point<int> getMouseXYRelative() const { return {}; }
+
+    void addAndMakeVisible (Component*) {}
+    void addAndMakeVisible (Component&) {}
+    void addChildComponent (Component*) {}
+    void setVisible (bool) {}
+    bool isVisible() const { return false; }
+    bool isShowing() const { return false; }
+    void setEnabled (bool) {}
+    void setOpaque (bool) {}
+    void setInterceptsMouseClicks (bool, bool) {}
+    void setBufferedToImage (bool) {}
+    void setRepaintsOnMouseActivity (bool) {}
+    void setTooltip (const String&) {}
+    Colour findColour (int) const { return Colour(); }
+
+    void repaint() {}
+    void repaint (int, int, int, int) {}
+    void repaint (Rectangle<int>) {}
+};
+
+class Button : public Component
+{
+public:
+    class Listener
+    {
+    public:
+        virtual ~Listener() = default;
+        virtual void buttonClicked (Button*) = 0;
+    };
+
+    Button (const String&) {}
+
+    virtual void paintButton (Graphics&, bool, bool) {}
+    void addListener (Listener*) {}
+    void setButtonText (const String&) {}
+    bool getToggleState() const { return false; }
+    void setToggleState (bool, NotificationType) {}
+    bool getClickingTogglesState() const { return false; }
+    void setClickingTogglesState (bool) {}
+
+    std::function<void()> onClick;
+};
+
+class UtilityButton : public Button
+{
+public:
+    UtilityButton (const String& label) : Button (label) {}
+    void setRadius (float) {}
+    void setCorners (bool, bool, bool, bool) {}
+    void setEnabledState (bool) {}
+};
+
+class Label : public Component
+{
+public:
+    enum
+    {
+        textColourId
+    };
+
+    Label (const String&, const String&) {}
+
+    void setFont (FontOptions) {}
+    void setText (const String&, NotificationType) {}
+    String getText() const { return String(); }
+    void setEditable (bool) {}
+    void setJustificationType (Justification) {}
+    void setColour (int, Colour) {}
+    void attachToComponent (Component*, bool) {}
+
+    std::function<void()> onTextChange;
+};
+
+class CustomTextBox : public Label
+{
+public:
+    CustomTextBox (const String& name, const String& text, const String&, const String&) : Label (name, text) {}
+};
+
+class ComboBox : public Component
+{
+public:
+    class Listener
+    {
+    public:
+        virtual ~Listener() = default;
+        virtual void comboBoxChanged (ComboBox*) = 0;
+    };
+
+    ComboBox() = default;
+    ComboBox (const String&) {}
+
+    void addListener (Listener*) {}
+    void addItem (const String&, int) {}
+    int getSelectedId() const { return 0; }
+    void setSelectedId (int, NotificationType = sendNotification) {}
+
+    std::function<void()> onChange;
+};
+
+class Viewport : public Component
+{
+public:
+    Viewport (const String& = String()) {}
+    void setViewedComponent (Component*, bool = true) {}
+    void setScrollBarsShown (bool, bool, bool = false, bool = false) {}
+    int getMaximumVisibleWidth() const { return 0; }
+    int getScrollBarThickness() const { return 8; }
+};
+
+class CallOutBox : public Component
+{
+public:
+    static CallOutBox& launchAsynchronously (std::unique_ptr<Component>, Rectangle<int>, Component*);
+};
+
+class Timer
+{
+public:
+    virtual ~Timer() = default;
+    virtual void timerCallback() = 0;
+
+    void startTimer (int) {}
+    void startTimerHz (int) {}
+    void stopTimer() {}
+    bool isTimerRunning() const { return false; }
+};
+
+class ParameterEditor : public Component
+{
+public:
+    ParameterEditor (Parameter*) {}
+    virtual void updateView() {}
+};
+
+class TextBoxParameterEditor : public ParameterEditor
+{
+public:
+    TextBoxParameterEditor (Parameter* parameter, int = 18, int = 160) : ParameterEditor (parameter) {}
+};
+
+class ComboBoxParameterEditor : public ParameterEditor
+{
+public:
+    ComboBoxParameterEditor (Parameter* parameter, int = 18, int = 160) : ParameterEditor (parameter) {}
+};
+
+class ToggleParameterEditor : public ParameterEditor
+{
+public:
+    ToggleParameterEditor (Parameter* parameter, int = 18, int = 160) : ParameterEditor (parameter) {}
+};
+
+class PathParameterEditor : public ParameterEditor
+{
+public:
+    PathParameterEditor (Parameter* parameter, int = 18, int = 160) : ParameterEditor (parameter) {}
+};
+
+class GenericEditor : public AudioProcessorEditor,
+                      public Component
+{
+public:
+    GenericEditor (GenericProcessor*) {}
+
+    virtual void startAcquisition() {}
+    virtual void stopAcquisition() {}
+    virtual void updateSettings() {}
+    virtual void selectedStreamHasChanged() {}
+    virtual void saveCustomParametersToXml (XmlElement*) {}
+    virtual void loadCustomParametersFromXml (XmlElement*) {}
+
+    uint16 getCurrentStream() const { return 0; }
+    void setDesiredWidth (int) {}
+
+    void addTextBoxParameterEditor (Parameter::ParameterScope, const String&, int, int) {}
+    void addComboBoxParameterEditor (Parameter::ParameterScope, const String&, int, int) {}
+    void addToggleParameterEditor (Parameter::ParameterScope, const String&, int, int) {}
+    void addPathParameterEditor (Parameter::ParameterScope, const String&, int, int) {}
+    void addBoundedValueParameterEditor (Parameter::ParameterScope, const String&, int, int) {}
+    void addTtlLineParameterEditor (Parameter::ParameterScope, const String&, int, int) {}
+    void addSelectedChannelsParameterEditor (Parameter::ParameterScope, const String&, int, int) {}
+};
+
+class Visualizer : public Component,
+                   public Timer
+{
+public:
+    Visualizer (GenericProcessor*) {}
+
+    virtual void refreshState() = 0;
+    virtual void refresh() = 0;
+    virtual void updateSettings() {}
+    virtual void beginAnimation() {}
+    virtual void endAnimation() {}
+
+    void timerCallback() override { refresh(); }
+};
+
+class VisualizerEditor : public GenericEditor,
+                         public Button::Listener
+{
+public:
+    VisualizerEditor (GenericProcessor* processor, const String&, int = 180) : GenericEditor (processor) {}
+
+    virtual Visualizer* createNewCanvas() = 0;
+    virtual void buttonEvent (Button*) {}
+
+    void buttonClicked (Button* button) override { buttonEvent (button); }
+    void startAcquisition() override {}
+    void stopAcquisition() override {}
+
+    std::unique_ptr<Visualizer> canvas;
+};
+
+#endif
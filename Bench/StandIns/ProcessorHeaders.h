@@ -0,0 +1,1345 @@
+#ifndef TTLDEBUGBENCHPROCESSORHEADERS_H_DEFINED
+#define TTLDEBUGBENCHPROCESSORHEADERS_H_DEFINED
+
+// Stand-ins for the parts of JUCE and the Open Ephys plugin API that the panels' hot paths use.
+// Anything on those paths behaves like the real thing; file, thread and logging calls do nothing.
+
+#include <algorithm>
+#include <atomic>
+#include <bitset>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace juce
+{
+}
+using namespace juce;
+
+typedef int8_t int8;
+typedef uint8_t uint8;
+typedef int16_t int16;
+typedef uint16_t uint16;
+typedef int32_t int32;
+typedef uint32_t uint32;
+typedef int64_t int64;
+typedef uint64_t uint64;
+typedef uint32 juce_wchar;
+
+#define JUCE_DECLARE_NON_COPYABLE(className)   \
+    className (const className&) = delete; \
+    className& operator= (const className&) = delete;
+#define JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(className) JUCE_DECLARE_NON_COPYABLE (className)
+#define jassert(expression)
+#define jassertfalse
+
+#define LOGC(...) ((void) 0)
+#define LOGD(...) ((void) 0)
+#define LOGE(...) ((void) 0)
+
+template <typename Type>
+Type jmin (Type a, Type b)
+{
+    return b < a ? b : a;
+}
+
+template <typename Type>
+Type jmax (Type a, Type b)
+{
+    return a < b ? b : a;
+}
+
+template <typename Type>
+Type jlimit (Type lowest, Type highest, Type value)
+{
+    return value < lowest ? lowest : (highest < value ? highest : value);
+}
+
+template <typename Type>
+int roundToInt (Type value)
+{
+    return int (std::lround (value));
+}
+
+template <typename... Types>
+void ignoreUnused (const Types&...)
+{
+}
+
+inline int countNumberOfBits (uint32 value)
+{
+    return int (std::bitset<32> (value).count());
+}
+
+inline int countNumberOfBits (uint64 value)
+{
+    return int (std::bitset<64> (value).count());
+}
+
+inline int findHighestSetBit (uint32 value)
+{
+    int bit = 0;
+
+    while ((value >>= 1) != 0)
+        bit++;
+
+    return bit;
+}
+
+//
+// Strings.
+
+class String
+{
+public:
+    String() = default;
+    String (const char* utf8) : text (utf8 != nullptr ? utf8 : "") {}
+    String (const std::string& text_) : text (text_) {}
+    explicit String (int value) : text (std::to_string (value)) {}
+    explicit String (unsigned value) : text (std::to_string (value)) {}
+    explicit String (long value) : text (std::to_string (value)) {}
+    explicit String (unsigned long value) : text (std::to_string (value)) {}
+    explicit String (long long value) : text (std::to_string (value)) {}
+    explicit String (unsigned long long value) : text (std::to_string (value)) {}
+    explicit String (float value) : text (formatNumber (value, 0)) {}
+    explicit String (double value, int decimals = 0) : text (formatNumber (value, decimals)) {}
+
+    static String charToString (juce_wchar character)
+    {
+        return String (std::string (1, char (character)));
+    }
+
+    static String toHexString (int64 value)
+    {
+        char buffer[24];
+        std::snprintf (buffer, sizeof (buffer), "%llx", (unsigned long long) value);
+        return String (buffer);
+    }
+
+    bool isEmpty() const { return text.empty(); }
+    bool isNotEmpty() const { return ! text.empty(); }
+    int length() const { return int (text.size()); }
+    char operator[] (int index) const { return index >= 0 && index < length() ? text[size_t (index)] : 0; }
+
+    const char* toRawUTF8() const { return text.c_str(); }
+    std::string toStdString() const { return text; }
+
+    bool operator== (const String& other) const { return text == other.text; }
+    bool operator!= (const String& other) const { return text != other.text; }
+    bool operator== (const char* other) const { return text == other; }
+    bool operator!= (const char* other) const { return text != other; }
+
+    String& operator+= (const String& other)
+    {
+        text += other.text;
+        return *this;
+    }
+
+    String operator+ (const String& other) const { return String (text + other.text); }
+    String operator+ (const char* other) const { return String (text + other); }
+
+    int getIntValue() const { return int (std::strtol (text.c_str(), nullptr, 10)); }
+    int64 getLargeIntValue() const { return int64 (std::strtoll (text.c_str(), nullptr, 10)); }
+    float getFloatValue() const { return float (getDoubleValue()); }
+    double getDoubleValue() const { return std::strtod (text.c_str(), nullptr); }
+    int getHexValue32() const { return int (getHexValue64()); }
+
+    int64 getHexValue64() const
+    {
+        uint64 value = 0;
+
+        for (char character : text)
+        {
+            const int digit = hexDigit (character);
+
+            if (digit >= 0)
+                value = (value << 4) | uint64 (digit);
+        }
+
+        return int64 (value);
+    }
+
+    bool containsChar (juce_wchar character) const { return text.find (char (character)) != std::string::npos; }
+    int indexOfChar (juce_wchar character) const
+    {
+        const size_t found = text.find (char (character));
+        return found == std::string::npos ? -1 : int (found);
+    }
+
+    bool containsOnly (const String& characters) const
+    {
+        return text.find_first_not_of (characters.text) == std::string::npos;
+    }
+
+    bool startsWith (const String& prefix) const { return text.compare (0, prefix.text.size(), prefix.text) == 0; }
+    bool startsWithChar (juce_wchar character) const { return ! text.empty() && text[0] == char (character); }
+    bool startsWithIgnoreCase (const String& prefix) const { return toLowerCase().startsWith (prefix.toLowerCase()); }
+    bool endsWith (const String& suffix) const
+    {
+        return text.size() >= suffix.text.size() && text.compare (text.size() - suffix.text.size(), suffix.text.size(), suffix.text) == 0;
+    }
+
+    String substring (int start) const { return substring (start, length()); }
+    String substring (int start, int end) const
+    {
+        start = jlimit (0, length(), start);
+        end = jlimit (start, length(), end);
+        return String (text.substr (size_t (start), size_t (end - start)));
+    }
+
+    String upToFirstOccurrenceOf (const String& sub, bool includeSub, bool) const
+    {
+        const size_t found = text.find (sub.text);
+        return found == std::string::npos ? *this : String (text.substr (0, found + (includeSub ? sub.text.size() : 0)));
+    }
+
+    String fromFirstOccurrenceOf (const String& sub, bool includeSub, bool) const
+    {
+        const size_t found = text.find (sub.text);
+        return found == std::string::npos ? String() : String (text.substr (found + (includeSub ? 0 : sub.text.size())));
+    }
+
+    String trim() const
+    {
+        const size_t first = text.find_first_not_of (" \t\r\n");
+
+        if (first == std::string::npos)
+            return String();
+
+        return String (text.substr (first, text.find_last_not_of (" \t\r\n") - first + 1));
+    }
+
+    String trimEnd() const
+    {
+        const size_t last = text.find_last_not_of (" \t\r\n");
+        return last == std::string::npos ? String() : String (text.substr (0, last + 1));
+    }
+
+    String toLowerCase() const
+    {
+        std::string lower = text;
+        std::transform (lower.begin(), lower.end(), lower.begin(), [] (unsigned char c)
+                        { return char (std::tolower (c)); });
+        return String (lower);
+    }
+
+    String toUpperCase() const
+    {
+        std::string upper = text;
+        std::transform (upper.begin(), upper.end(), upper.begin(), [] (unsigned char c)
+                        { return char (std::toupper (c)); });
+        return String (upper);
+    }
+
+    String replace (const String& target, const String& replacement) const
+    {
+        if (target.isEmpty())
+            return *this;
+
+        std::string result = text;
+
+        for (size_t at = result.find (target.text); at != std::string::npos; at = result.find (target.text, at + replacement.text.size()))
+            result.replace (at, target.text.size(), replacement.text);
+
+        return String (result);
+    }
+
+    String retainCharacters (const String& characters) const
+    {
+        std::string result;
+
+        for (char character : text)
+        {
+            if (characters.text.find (character) != std::string::npos)
+                result += character;
+        }
+
+        return String (result);
+    }
+
+    String paddedLeft (juce_wchar padding, int minimumLength) const
+    {
+        return length() >= minimumLength ? *this : String (std::string (size_t (minimumLength - length()), char (padding)) + text);
+    }
+
+    template <typename... Args>
+    static String formatted (const char* format, Args... args)
+    {
+        char buffer[512];
+        std::snprintf (buffer, sizeof (buffer), format, args...);
+        return String (buffer);
+    }
+
+private:
+    static std::string formatNumber (double value, int decimals)
+    {
+        char buffer[64];
+
+        if (decimals > 0)
+            std::snprintf (buffer, sizeof (buffer), "%.*f", decimals, value);
+        else
+            std::snprintf (buffer, sizeof (buffer), "%g", value);
+
+        return buffer;
+    }
+
+    static int hexDigit (char character)
+    {
+        if (character >= '0' && character <= '9')
+            return character - '0';
+        if (character >= 'a' && character <= 'f')
+            return character - 'a' + 10;
+        if (character >= 'A' && character <= 'F')
+            return character - 'A' + 10;
+        return -1;
+    }
+
+    std::string text;
+};
+
+inline String operator+ (const char* first, const String& second)
+{
+    return String (first) + second;
+}
+
+inline String& operator<< (String& string, const String& text)
+{
+    return string += text;
+}
+
+inline String& operator<< (String& string, const char* text)
+{
+    return string += String (text);
+}
+
+template <typename ElementType>
+class Array
+{
+public:
+    Array() = default;
+    Array (std::initializer_list<ElementType> items) : elements (items) {}
+
+    int size() const { return int (elements.size()); }
+    bool isEmpty() const { return elements.empty(); }
+    ElementType operator[] (int index) const { return index >= 0 && index < size() ? elements[size_t (index)] : ElementType(); }
+    ElementType& getReference (int index) { return elements[size_t (index)]; }
+    ElementType getFirst() const { return elements.empty() ? ElementType() : elements.front(); }
+    ElementType getLast() const { return elements.empty() ? ElementType() : elements.back(); }
+    ElementType* getRawDataPointer() { return elements.data(); }
+
+    void add (const ElementType& element) { elements.push_back (element); }
+    void insert (int index, const ElementType& element) { elements.insert (elements.begin() + jlimit (0, size(), index), element); }
+    void set (int index, const ElementType& element) { elements[size_t (index)] = element; }
+    void remove (int index) { elements.erase (elements.begin() + index); }
+    void clear() { elements.clear(); }
+    void clearQuick() { elements.clear(); }
+    void resize (int newSize) { elements.resize (size_t (newSize)); }
+    void ensureStorageAllocated (int minimumSize) { elements.reserve (size_t (minimumSize)); }
+    void fill (const ElementType& value) { std::fill (elements.begin(), elements.end(), value); }
+    void swap (int first, int second) { std::swap (elements[size_t (first)], elements[size_t (second)]); }
+    void sort() { std::sort (elements.begin(), elements.end()); }
+
+    bool contains (const ElementType& element) const { return indexOf (element) >= 0; }
+    int indexOf (const ElementType& element) const
+    {
+        auto found = std::find (elements.begin(), elements.end(), element);
+        return found == elements.end() ? -1 : int (found - elements.begin());
+    }
+
+    auto begin() { return elements.begin(); }
+    auto end() { return elements.end(); }
+    auto begin() const { return elements.begin(); }
+    auto end() const { return elements.end(); }
+
+private:
+    std::vector<ElementType> elements;
+};
+
+class StringArray
+{
+public:
+    StringArray() = default;
+    StringArray (std::initializer_list<const char*> items)
+    {
+        for (auto item : items)
+            strings.push_back (String (item));
+    }
+
+    // Splits at any of "breakCharacters". Quotes aren't supported; nothing here uses them.
+    static StringArray fromTokens (const String& text, const String& breakCharacters, const String&)
+    {
+        StringArray tokens;
+        std::string current;
+
+        for (int index = 0; index < text.length(); index++)
+        {
+            if (breakCharacters.containsChar (juce_wchar (text[index])))
+            {
+                tokens.add (String (current));
+                current.clear();
+            }
+            else
+            {
+                current += text[index];
+            }
+        }
+
+        tokens.add (String (current));
+        return tokens;
+    }
+
+    int size() const { return int (strings.size()); }
+    bool isEmpty() const { return strings.empty(); }
+    String operator[] (int index) const { return index >= 0 && index < size() ? strings[size_t (index)] : String(); }
+    String& getReference (int index) { return strings[size_t (index)]; }
+
+    void add (const String& string) { strings.push_back (string); }
+    void clear() { strings.clear(); }
+
+    void trim()
+    {
+        for (auto& string : strings)
+            string = string.trim();
+    }
+
+    void removeEmptyStrings()
+    {
+        strings.erase (std::remove_if (strings.begin(), strings.end(), [] (const String& string)
+                                       { return string.isEmpty(); }),
+                       strings.end());
+    }
+
+    String joinIntoString (const String& separator) const
+    {
+        String joined;
+
+        for (size_t index = 0; index < strings.size(); index++)
+            joined += (index > 0 ? separator : String()) + strings[index];
+
+        return joined;
+    }
+
+    auto begin() { return strings.begin(); }
+    auto end() { return strings.end(); }
+    auto begin() const { return strings.begin(); }
+    auto end() const { return strings.end(); }
+
+private:
+    std::vector<String> strings;
+};
+
+template <typename ObjectType>
+class OwnedArray
+{
+public:
+    OwnedArray() = default;
+    ~OwnedArray() { clear(); }
+
+    int size() const { return int (objects.size()); }
+    ObjectType* operator[] (int index) const { return index >= 0 && index < size() ? objects[size_t (index)] : nullptr; }
+    ObjectType* getLast() const { return objects.empty() ? nullptr : objects.back(); }
+    bool contains (const ObjectType* object) const { return std::find (objects.begin(), objects.end(), object) != objects.end(); }
+
+    ObjectType* add (ObjectType* object)
+    {
+        objects.push_back (object);
+        return object;
+    }
+
+    void clear()
+    {
+        for (auto object : objects)
+            delete object;
+
+        objects.clear();
+    }
+
+    ObjectType** begin() { return objects.data(); }
+    ObjectType** end() { return objects.data() + objects.size(); }
+    ObjectType* const* begin() const { return objects.data(); }
+    ObjectType* const* end() const { return objects.data() + objects.size(); }
+
+private:
+    std::vector<ObjectType*> objects;
+
+    JUCE_DECLARE_NON_COPYABLE (OwnedArray)
+};
+
+template <typename ElementType>
+class HeapBlock
+{
+public:
+    void malloc (size_t count) { storage.assign (count, ElementType()); }
+    void calloc (size_t count) { storage.assign (count, ElementType()); }
+    void allocate (size_t count, bool) { storage.assign (count, ElementType()); }
+    void free() { storage.clear(); }
+    ElementType& operator[] (size_t index) { return storage[index]; }
+    ElementType* get() { return storage.data(); }
+
+private:
+    std::vector<ElementType> storage;
+};
+
+template <typename ValueType>
+class Range
+{
+public:
+    Range (ValueType start_, ValueType end_) : start (start_), end (end_) {}
+    ValueType getStart() const { return start; }
+    ValueType getEnd() const { return end; }
+    ValueType getLength() const { return end - start; }
+
+private:
+    ValueType start;
+    ValueType end;
+};
+
+//
+// Variants.
+
+class var
+{
+public:
+    var() = default;
+    var (int value) : type (Int), intValue (value) {}
+    var (int64 value) : type (Int), intValue (value) {}
+    var (double value) : type (Double), doubleValue (value) {}
+    var (float value) : type (Double), doubleValue (value) {}
+    var (bool value) : type (Bool), intValue (value ? 1 : 0) {}
+    var (const String& value) : type (Text), textValue (value) {}
+    var (const char* value) : type (Text), textValue (value) {}
+
+    bool isVoid() const { return type == Void; }
+    bool isString() const { return type == Text; }
+    bool isInt() const { return type == Int; }
+    bool isDouble() const { return type == Double; }
+    bool isBool() const { return type == Bool; }
+
+    operator int() const { return int (toInt64()); }
+    operator int64() const { return toInt64(); }
+    operator float() const { return float (toDouble()); }
+    operator double() const { return toDouble(); }
+    operator bool() const { return toInt64() != 0; }
+    operator String() const { return toString(); }
+
+    String toString() const
+    {
+        switch (type)
+        {
+            case Int:
+            case Bool:
+                return String (intValue);
+            case Double:
+                return String (doubleValue);
+            case Text:
+                return textValue;
+            default:
+                return String();
+        }
+    }
+
+private:
+    enum Type
+    {
+        Void,
+        Int,
+        Double,
+        Bool,
+        Text
+    };
+
+    int64 toInt64() const
+    {
+        switch (type)
+        {
+            case Int:
+            case Bool:
+                return intValue;
+            case Double:
+                return int64 (doubleValue);
+            case Text:
+                return textValue.getLargeIntValue();
+            default:
+                return 0;
+        }
+    }
+
+    double toDouble() const
+    {
+        switch (type)
+        {
+            case Int:
+            case Bool:
+                return double (intValue);
+            case Double:
+                return doubleValue;
+            case Text:
+                return textValue.getDoubleValue();
+            default:
+                return 0.0;
+        }
+    }
+
+    Type type = Void;
+    int64 intValue = 0;
+    double doubleValue = 0.0;
+    String textValue;
+};
+
+//
+// Time.
+
+class Time
+{
+public:
+    static int64 getHighResolutionTicks()
+    {
+        return int64 (std::chrono::duration_cast<std::chrono::nanoseconds> (std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    static int64 getHighResolutionTicksPerSecond()
+    {
+        return 1000000000;
+    }
+
+    static double highResolutionTicksToSeconds (int64 ticks)
+    {
+        return double (ticks) * 1.0e-9;
+    }
+
+    static uint32 getMillisecondCounter()
+    {
+        return uint32 (getHighResolutionTicks() / 1000000);
+    }
+
+    static double getMillisecondCounterHiRes()
+    {
+        return double (getHighResolutionTicks()) * 1.0e-6;
+    }
+
+    static Time getCurrentTime()
+    {
+        return Time();
+    }
+
+    String formatted (const String&) const
+    {
+        return "bench";
+    }
+};
+
+struct FloatVectorOperations
+{
+    static void fill (float* destination, float value, int count)
+    {
+        std::fill (destination, destination + count, value);
+    }
+
+    static void clear (float* destination, int count)
+    {
+        std::fill (destination, destination + count, 0.0f);
+    }
+};
+
+//
+// Files and threads. The bench leaves logging and replay off, so none of these do anything.
+
+class Result
+{
+public:
+    static Result ok() { return Result(); }
+    static Result fail (const String& message)
+    {
+        Result result;
+        result.error = message.isEmpty() ? String ("failed") : message;
+        return result;
+    }
+
+    bool wasOk() const { return error.isEmpty(); }
+    bool failed() const { return error.isNotEmpty(); }
+    String getErrorMessage() const { return error; }
+
+private:
+    String error;
+};
+
+class File
+{
+public:
+    File() = default;
+    File (const String& path_) : path (path_) {}
+
+    File getChildFile (const String& name) const { return File (path + "/" + name); }
+    File getParentDirectory() const { return *this; }
+    File getNonexistentSibling() const { return *this; }
+    static File getCurrentWorkingDirectory() { return File ("."); }
+
+    bool exists() const { return false; }
+    bool existsAsFile() const { return false; }
+    bool createDirectory() const { return false; }
+    bool deleteFile() const { return false; }
+    Result create() const { return Result::fail ("the bench doesn't write files"); }
+    int64 getSize() const { return 0; }
+    String getFullPathName() const { return path; }
+    String getFileName() const { return path.fromFirstOccurrenceOf ("/", false, false); }
+
+private:
+    String path;
+};
+
+class MemoryMappedFile
+{
+public:
+    enum AccessMode
+    {
+        readOnly,
+        readWrite
+    };
+
+    MemoryMappedFile (const File&, AccessMode, bool = false) {}
+    MemoryMappedFile (const File&, Range<int64>, AccessMode, bool = false) {}
+
+    void* getData() const { return nullptr; }
+    size_t getSize() const { return 0; }
+    Range<int64> getRange() const { return Range<int64> (0, 0); }
+};
+
+class OutputStream
+{
+public:
+    virtual ~OutputStream() = default;
+    bool write (const void*, size_t) { return false; }
+    bool writeByte (char) { return false; }
+    bool setPosition (int64) { return false; }
+    int64 getPosition() { return 0; }
+    void flush() {}
+};
+
+class FileOutputStream : public OutputStream
+{
+public:
+    FileOutputStream (const File&, size_t = 16384) {}
+    bool openedOk() const { return false; }
+    Result truncate() { return Result::fail ("the bench doesn't write files"); }
+    Result getStatus() { return Result::fail ("the bench doesn't write files"); }
+};
+
+class FileInputStream
+{
+public:
+    FileInputStream (const File&) {}
+    bool openedOk() const { return false; }
+    int read (void*, int) { return 0; }
+    bool setPosition (int64) { return false; }
+    int64 getTotalLength() { return 0; }
+};
+
+class WaitableEvent
+{
+public:
+    void signal() const {}
+    void reset() const {}
+    bool wait (double = -1.0) const { return true; }
+};
+
+class Thread
+{
+public:
+    Thread (const String&) {}
+    virtual ~Thread() = default;
+    virtual void run() = 0;
+
+    bool startThread() { return false; }
+    bool startThread (int) { return false; }
+    bool stopThread (int) { return true; }
+    void signalThreadShouldExit() {}
+    bool threadShouldExit() const { return true; }
+    bool isThreadRunning() const { return false; }
+    void notify() const {}
+    bool wait (double) const { return true; }
+};
+
+class CriticalSection
+{
+};
+
+class ScopedLock
+{
+public:
+    ScopedLock (const CriticalSection&) {}
+};
+
+class AsyncUpdater
+{
+public:
+    virtual ~AsyncUpdater() = default;
+    virtual void handleAsyncUpdate() = 0;
+    void triggerAsyncUpdate() {}
+    void cancelPendingUpdate() {}
+    void handleUpdateNowIfNeeded() {}
+};
+
+//
+// Audio.
+
+template <typename SampleType>
+class AudioBuffer
+{
+public:
+    AudioBuffer() = default;
+    AudioBuffer (int numChannels_, int numSamples_) { setSize (numChannels_, numSamples_); }
+
+    void setSize (int numChannels_, int numSamples_)
+    {
+        numChannels = numChannels_;
+        numSamples = numSamples_;
+        samples.assign (size_t (numChannels * numSamples), SampleType());
+    }
+
+    int getNumChannels() const { return numChannels; }
+    int getNumSamples() const { return numSamples; }
+    SampleType* getWritePointer (int channel) { return samples.data() + size_t (channel * numSamples); }
+    const SampleType* getReadPointer (int channel) const { return samples.data() + size_t (channel * numSamples); }
+
+private:
+    int numChannels = 0;
+    int numSamples = 0;
+    std::vector<SampleType> samples;
+};
+
+typedef AudioBuffer<float> AudioSampleBuffer;
+
+class AudioProcessorEditor
+{
+public:
+    virtual ~AudioProcessorEditor() = default;
+};
+
+class XmlElement
+{
+public:
+    XmlElement* createNewChildElement (const String&) { return this; }
+    XmlElement* getChildByName (const String&) const { return nullptr; }
+    void setAttribute (const String&, const String&) {}
+    void setAttribute (const String&, int) {}
+    void setAttribute (const String&, double) {}
+    String getStringAttribute (const String&, const String& fallback = String()) const { return fallback; }
+    int getIntAttribute (const String&, int fallback = 0) const { return fallback; }
+    double getDoubleAttribute (const String&, double fallback = 0.0) const { return fallback; }
+    bool getBoolAttribute (const String&, bool fallback = false) const { return fallback; }
+};
+
+#define forEachXmlChildElement(parent, child) for (XmlElement* child = nullptr; child != nullptr;)
+
+//
+// Open Ephys plugin API.
+
+class GenericProcessor;
+class GenericEditor;
+class DataStream;
+
+class InfoObject
+{
+public:
+    String getName() const { return name; }
+    void setName (const String& newName) { name = newName; }
+
+private:
+    String name;
+};
+
+class Parameter
+{
+public:
+    enum ParameterScope
+    {
+        PROCESSOR_SCOPE,
+        STREAM_SCOPE,
+        SPIKE_CHANNEL_SCOPE
+    };
+
+    Parameter (const String& name_, const String& displayName_, const var& defaultValue)
+        : name (name_), displayName (displayName_), value (defaultValue), nextValue (defaultValue)
+    {
+    }
+
+    virtual ~Parameter() = default;
+
+    // A copy for one stream, with the same name and default.
+    virtual std::unique_ptr<Parameter> clone() const = 0;
+
+    String getName() const { return name; }
+    String getDisplayName() const { return displayName; }
+    uint16 getStreamId() const { return streamId; }
+    var getValue() const { return value; }
+    String getValueAsString() const { return value.toString(); }
+
+    // The bench never builds an editor, so nothing locks parameters during acquisition.
+    bool shouldDeactivateDuringAcquisition() const { return false; }
+
+    // Like the host: the change is held as the next value, and the owner is asked to apply it through
+    // GenericProcessor::setParameter(). Everything runs on the calling thread.
+    virtual void setNextValue (var newValue, bool = true)
+    {
+        nextValue = newValue;
+        requestChange();
+    }
+
+    // Called by GenericProcessor::setParameter().
+    void updateValue() { value = nextValue; }
+
+    void attach (GenericProcessor* owner_, uint16 streamId_)
+    {
+        owner = owner_;
+        streamId = streamId_;
+    }
+
+protected:
+    void requestChange();
+
+    String name;
+    String displayName;
+    var value;
+    var nextValue;
+    GenericProcessor* owner = nullptr;
+    uint16 streamId = 0;
+};
+
+template <typename Derived>
+class ClonedParameter : public Parameter
+{
+public:
+    using Parameter::Parameter;
+
+    std::unique_ptr<Parameter> clone() const override
+    {
+        return std::make_unique<Derived> (static_cast<const Derived&> (*this));
+    }
+};
+
+class IntParameter : public ClonedParameter<IntParameter>
+{
+public:
+    using ClonedParameter::ClonedParameter;
+    int getIntValue() const { return int (value); }
+};
+
+class FloatParameter : public ClonedParameter<FloatParameter>
+{
+public:
+    using ClonedParameter::ClonedParameter;
+    float getFloatValue() const { return float (value); }
+};
+
+class BooleanParameter : public ClonedParameter<BooleanParameter>
+{
+public:
+    using ClonedParameter::ClonedParameter;
+    bool getBoolValue() const { return bool (value); }
+};
+
+class StringParameter : public ClonedParameter<StringParameter>
+{
+public:
+    using ClonedParameter::ClonedParameter;
+};
+
+class PathParameter : public ClonedParameter<PathParameter>
+{
+public:
+    using ClonedParameter::ClonedParameter;
+};
+
+class TtlLineParameter : public ClonedParameter<TtlLineParameter>
+{
+public:
+    using ClonedParameter::ClonedParameter;
+    int getSelectedLine() const { return int (value); }
+};
+
+class CategoricalParameter : public ClonedParameter<CategoricalParameter>
+{
+public:
+    CategoricalParameter (const String& name_, const String& displayName_, const Array<String>& categories_, int defaultIndex)
+        : ClonedParameter (name_, displayName_, var (defaultIndex)), categories (categories_)
+    {
+    }
+
+    int getSelectedIndex() const { return int (value); }
+    String getSelectedString() const { return categories[getSelectedIndex()]; }
+
+private:
+    Array<String> categories;
+};
+
+class DataStream : public InfoObject
+{
+public:
+    DataStream (uint16 streamId_, float sampleRate_) : streamId (streamId_), sampleRate (sampleRate_) {}
+
+    uint16 getStreamId() const { return streamId; }
+    float getSampleRate() const { return sampleRate; }
+    int getChannelCount() const { return 0; }
+
+    Parameter* getParameter (const String& name) const
+    {
+        for (auto& parameter : parameters)
+        {
+            if (parameter->getName() == name)
+                return parameter.get();
+        }
+
+        return nullptr;
+    }
+
+    void addParameter (std::unique_ptr<Parameter> parameter) { parameters.push_back (std::move (parameter)); }
+
+private:
+    uint16 streamId;
+    float sampleRate;
+    std::vector<std::unique_ptr<Parameter>> parameters;
+};
+
+class EventChannel
+{
+public:
+    enum Type
+    {
+        TTL,
+        TEXT
+    };
+
+    struct Settings
+    {
+        Type type;
+        String name;
+        String description;
+        String identifier;
+        DataStream* stream;
+        int maxTTLBits = 64;
+    };
+
+    EventChannel (const Settings& settings_) : settings (settings_) {}
+
+    void addProcessor (GenericProcessor*) {}
+    uint16 getStreamId() const { return settings.stream != nullptr ? settings.stream->getStreamId() : 0; }
+    int getMaxTTLBits() const { return settings.maxTTLBits; }
+
+private:
+    Settings settings;
+};
+
+class ContinuousChannel
+{
+public:
+    enum Type
+    {
+        ELECTRODE,
+        AUX,
+        ADC
+    };
+
+    struct Settings
+    {
+        Type type;
+        String name;
+        String description;
+        String identifier;
+        float bitVolts;
+        DataStream* stream;
+    };
+
+    ContinuousChannel (const Settings& settings_) : settings (settings_) {}
+
+    void addProcessor (GenericProcessor*) {}
+    int getGlobalIndex() const { return 0; }
+    uint16 getStreamId() const { return settings.stream != nullptr ? settings.stream->getStreamId() : 0; }
+
+private:
+    Settings settings;
+};
+
+class Event
+{
+public:
+    Event (uint16 streamId_, int64 sampleNumber_) : streamId (streamId_), sampleNumber (sampleNumber_) {}
+    virtual ~Event() = default;
+
+    uint16 getStreamId() const { return streamId; }
+    int64 getSampleNumber() const { return sampleNumber; }
+
+private:
+    uint16 streamId;
+    int64 sampleNumber;
+};
+
+class TTLEvent;
+typedef std::shared_ptr<TTLEvent> TTLEventPtr;
+
+class TTLEvent : public Event
+{
+public:
+    TTLEvent (uint16 streamId_, int64 sampleNumber_, uint8 line_, bool state_)
+        : Event (streamId_, sampleNumber_), line (line_), state (state_)
+    {
+    }
+
+    // Like the host, one allocation per event.
+    static TTLEventPtr createTTLEvent (EventChannel* channel, int64 sampleNumber, uint8 line, bool state)
+    {
+        return std::make_shared<TTLEvent> (channel != nullptr ? channel->getStreamId() : 0, sampleNumber, line, state);
+    }
+
+    // A list of events, one per line the channel carries.
+    static Array<TTLEventPtr> createTTLEvent (EventChannel* channel, int64 sampleNumber, uint64 word)
+    {
+        Array<TTLEventPtr> events;
+        const int numLines = channel != nullptr ? channel->getMaxTTLBits() : 64;
+
+        for (int line = 0; line < numLines; line++)
+            events.add (createTTLEvent (channel, sampleNumber, uint8 (line), ((word >> line) & 1) != 0));
+
+        return events;
+    }
+
+    uint8 getLine() const { return line; }
+    bool getState() const { return state; }
+    uint64 getWord() const { return state ? uint64 (1) << line : 0; }
+
+private:
+    uint8 line;
+    bool state;
+};
+
+class TextEvent;
+typedef std::shared_ptr<TextEvent> TextEventPtr;
+
+class TextEvent : public Event
+{
+public:
+    TextEvent (uint16 streamId_, int64 sampleNumber_, const String& text_) : Event (streamId_, sampleNumber_), text (text_) {}
+
+    static TextEventPtr createTextEvent (EventChannel* channel, int64 sampleNumber, const String& text)
+    {
+        return std::make_shared<TextEvent> (channel != nullptr ? channel->getStreamId() : 0, sampleNumber, text);
+    }
+
+private:
+    String text;
+};
+
+namespace CoreServices
+{
+bool getAcquisitionStatus();
+void sendStatusMessage (const String& message);
+void updateSignalChain (GenericEditor* editor);
+File getRecordingParentDirectory();
+} // namespace CoreServices
+
+// Processor-scope parameters live on the processor. Stream-scope ones are templates, copied onto each stream
+// by setUpStreams(). Events go nowhere; the bench only counts them.
+class GenericProcessor
+{
+public:
+    GenericProcessor (const String& name_) : name (name_) {}
+    virtual ~GenericProcessor() = default;
+
+    virtual void registerParameters() {}
+    virtual AudioProcessorEditor* createEditor() { return nullptr; }
+    virtual void updateSettings() {}
+    virtual bool startAcquisition() { return true; }
+    virtual bool stopAcquisition() { return true; }
+    virtual void process (AudioBuffer<float>& buffer) = 0;
+    virtual void handleTTLEvent (TTLEventPtr) {}
+    virtual void parameterValueChanged (Parameter*) {}
+    virtual void saveCustomParametersToXml (XmlElement*) {}
+    virtual void loadCustomParametersFromXml (XmlElement*) {}
+
+    // Applies the parameter passed to parameterChangeRequest(), then calls parameterValueChanged() for it.
+    virtual void setParameter (int, float)
+    {
+        if (currentParameter == nullptr)
+            return;
+
+        Parameter* parameter = currentParameter;
+        currentParameter = nullptr;
+
+        parameter->updateValue();
+        parameterValueChanged (parameter);
+    }
+
+    void parameterChangeRequest (Parameter* parameter)
+    {
+        currentParameter = parameter;
+        setParameter (-1, 0.0f);
+    }
+
+    String getName() const { return name; }
+    int getNodeId() const { return 100; }
+    GenericEditor* getEditor() const { return nullptr; }
+    int getTotalContinuousChannels() const { return 0; }
+
+    Parameter* getParameter (const String& parameterName) const
+    {
+        for (auto& parameter : processorParameters)
+        {
+            if (parameter->getName() == parameterName)
+                return parameter.get();
+        }
+
+        return nullptr;
+    }
+
+    Array<const DataStream*> getDataStreams() const
+    {
+        Array<const DataStream*> streams;
+
+        for (auto stream : dataStreams)
+            streams.add (stream);
+
+        return streams;
+    }
+
+    DataStream* getDataStream (uint16 streamId) const
+    {
+        for (auto stream : dataStreams)
+        {
+            if (stream->getStreamId() == streamId)
+                return stream;
+        }
+
+        return nullptr;
+    }
+
+    int64 getFirstSampleNumberForBlock (uint16) const { return blockFirstSample; }
+    uint32 getNumSamplesInBlock (uint16) const { return blockSamples; }
+
+    void addEvent (TTLEventPtr, int) { eventsAdded++; }
+    void addEvent (TextEventPtr, int) { eventsAdded++; }
+
+    // Hands every queued input event to handleTTLEvent(), in order.
+    int checkForEvents (bool = false)
+    {
+        for (auto& event : inputEvents)
+            handleTTLEvent (event);
+
+        return int (inputEvents.size());
+    }
+
+    void addIntParameter (Parameter::ParameterScope scope, const String& parameterName, const String& displayName, const String&, int defaultValue, int, int, bool = false)
+    {
+        addParameter (scope, std::make_unique<IntParameter> (parameterName, displayName, var (defaultValue)));
+    }
+
+    void addFloatParameter (Parameter::ParameterScope scope, const String& parameterName, const String& displayName, const String&, const String&, float defaultValue, float, float, float, bool = false)
+    {
+        addParameter (scope, std::make_unique<FloatParameter> (parameterName, displayName, var (defaultValue)));
+    }
+
+    void addBooleanParameter (Parameter::ParameterScope scope, const String& parameterName, const String& displayName, const String&, bool defaultValue, bool = false)
+    {
+        addParameter (scope, std::make_unique<BooleanParameter> (parameterName, displayName, var (defaultValue)));
+    }
+
+    void addStringParameter (Parameter::ParameterScope scope, const String& parameterName, const String& displayName, const String&, const String& defaultValue, bool = false)
+    {
+        addParameter (scope, std::make_unique<StringParameter> (parameterName, displayName, var (defaultValue)));
+    }
+
+    void addCategoricalParameter (Parameter::ParameterScope scope, const String& parameterName, const String& displayName, const String&, const Array<String>& categories, int defaultIndex, bool = false)
+    {
+        addParameter (scope, std::make_unique<CategoricalParameter> (parameterName, displayName, categories, defaultIndex));
+    }
+
+    void addTtlLineParameter (Parameter::ParameterScope scope, const String& parameterName, const String& displayName, const String&, int = 8, bool = false, bool = false, bool = false)
+    {
+        addParameter (scope, std::make_unique<TtlLineParameter> (parameterName, displayName, var (0)));
+    }
+
+    void addPathParameter (Parameter::ParameterScope scope, const String& parameterName, const String& displayName, const String&, const File&, const StringArray&, bool, bool = false)
+    {
+        addParameter (scope, std::make_unique<PathParameter> (parameterName, displayName, var ("")));
+    }
+
+    //
+    // Bench controls; not part of the plugin API.
+
+    // Replaces the input streams, copies the stream-scope parameters onto each, and calls updateSettings().
+    void setUpStreams (int numStreams, float sampleRate)
+    {
+        dataStreams.clear();
+
+        for (int index = 0; index < numStreams; index++)
+        {
+            DataStream* stream = dataStreams.add (new DataStream (uint16 (index + 1), sampleRate));
+            stream->setName ("stream " + String (index + 1));
+
+            for (auto& parameter : streamParameters)
+            {
+                std::unique_ptr<Parameter> copy = parameter->clone();
+                copy->attach (this, stream->getStreamId());
+                stream->addParameter (std::move (copy));
+            }
+        }
+
+        updateSettings();
+    }
+
+    // Every stream shares the same block.
+    void setBlock (int64 firstSample, uint32 numSamples)
+    {
+        blockFirstSample = firstSample;
+        blockSamples = numSamples;
+    }
+
+    // Events for the next checkForEvents(). The bench builds these before timing anything.
+    std::vector<TTLEventPtr> inputEvents;
+
+    uint64 eventsAdded = 0;
+
+protected:
+    std::shared_ptr<GenericEditor> editor;
+    OwnedArray<EventChannel> eventChannels;
+    OwnedArray<ContinuousChannel> continuousChannels;
+    OwnedArray<DataStream> dataStreams;
+
+    bool isEnabled = true;
+
+private:
+    void addParameter (Parameter::ParameterScope scope, std::unique_ptr<Parameter> parameter)
+    {
+        if (scope == Parameter::STREAM_SCOPE)
+        {
+            streamParameters.push_back (std::move (parameter));
+        }
+        else
+        {
+            parameter->attach (this, 0);
+            processorParameters.push_back (std::move (parameter));
+        }
+    }
+
+    String name;
+    Parameter* currentParameter = nullptr;
+    std::vector<std::unique_ptr<Parameter>> processorParameters;
+    std::vector<std::unique_ptr<Parameter>> streamParameters;
+    int64 blockFirstSample = 0;
+    uint32 blockSamples = 0;
+};
+
+inline void Parameter::requestChange()
+{
+    if (owner != nullptr)
+        owner->parameterChangeRequest (this);
+    else
+        updateValue();
+}
+
+#endif
@@ -0,0 +1,39 @@
+#include "EditorHeaders.h"
+#include "StandIns.h"
+
+bool TTLDebugBench::acquisitionActive = false;
+
+namespace juce
+{
+namespace Colours
+{
+    const Colour transparentWhite, grey, lime, black, white, red, yellow, darkgrey, orange;
+} // namespace Colours
+} // namespace juce
+
+bool CoreServices::getAcquisitionStatus()
+{
+    return TTLDebugBench::acquisitionActive;
+}
+
+void CoreServices::sendStatusMessage (const String&)
+{
+}
+
+void CoreServices::updateSignalChain (GenericEditor*)
+{
+}
+
+File CoreServices::getRecordingParentDirectory()
+{
+    return File();
+}
+
+// Nothing on the bench opens one.
+CallOutBox& CallOutBox::launchAsynchronously (std::unique_ptr<Component>, Rectangle<int>, Component*)
+{
+    static CallOutBox box;
+    return box;
+}
+
+// This is the end of the file.
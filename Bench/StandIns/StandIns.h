@@ -0,0 +1,11 @@
+#ifndef TTLDEBUGBENCHSTANDINS_H_DEFINED
+#define TTLDEBUGBENCHSTANDINS_H_DEFINED
+
+// Host state the bench drives directly. None of this is part of the plugin API.
+namespace TTLDebugBench
+{
+// What CoreServices::getAcquisitionStatus() returns.
+extern bool acquisitionActive;
+} // namespace TTLDebugBench
+
+#endif
@@ -0,0 +1,6 @@
+#ifndef TTLDEBUGBENCHVISUALIZEREDITORHEADERS_H_DEFINED
+#define TTLDEBUGBENCHVISUALIZEREDITORHEADERS_H_DEFINED
+
+#include "EditorHeaders.h"
+
+#endif
@@ -0,0 +1,6 @@
+#ifndef TTLDEBUGBENCHVISUALIZERWINDOWHEADERS_H_DEFINED
+#define TTLDEBUGBENCHVISUALIZERWINDOWHEADERS_H_DEFINED
+
+#include "EditorHeaders.h"
+
+#endif
@@ -0,0 +1,147 @@
+#include "Barcode.h"
+#include "PanelBase.h"
+#include <cmath>
+
+using namespace TTLDebugTools;
+
+// Barcode generator.
+
+void TTLBarcodeGenerator::configure (int line_, int numBits_, double bitSamples_, int64 intervalSamples_)
+{
+    line = jlimit (0, TTLDEBUG_PANEL_TOTAL_BITS - 1, line_);
+    numBits = jlimit (1, TTLDEBUG_BARCODE_MAX_BITS, numBits_);
+    bitSamples = jmax (1.0, bitSamples_);
+
+    // A barcode has to end, stop bit included, before the next one starts.
+    intervalSamples = jmax (intervalSamples_, int64 (std::ceil ((numBits + 3) * bitSamples)));
+
+    running = false;
+}
+
+void TTLBarcodeGenerator::begin (int64 firstSample)
+{
+    counter = 0;
+    running = true;
+
+    scheduleBarcode (firstSample);
+}
+
+void TTLBarcodeGenerator::scheduleBarcode (int64 startSample)
+{
+    barcodeStart = startSample;
+    numEdges = 0;
+    nextEdge = 0;
+
+    // Bit 0 is the start bit, then the data, then the stop bit. Only level changes need an edge.
+    bool level = false;
+
+    for (int bit = 0; bit < numBits + 2; bit++)
+    {
+        bool bitLevel = false;
+
+        if (bit == 0)
+            bitLevel = true;
+        else if (bit <= numBits)
+            bitLevel = ((counter >> (bit - 1)) & 1) != 0;
+
+        if (bitLevel == level)
+            continue;
+
+        edgeSamples[numEdges] = startSample + int64 (std::llround (bit * bitSamples));
+        edgeLevels[numEdges] = bitLevel;
+        numEdges++;
+
+        level = bitLevel;
+    }
+}
+
+bool TTLBarcodeGenerator::takeEdge()
+{
+    const bool level = edgeLevels[nextEdge++];
+
+    if (nextEdge == numEdges)
+    {
+        counter++;
+        scheduleBarcode (barcodeStart + intervalSamples);
+    }
+
+    return level;
+}
+
+// Barcode decoder.
+
+void TTLBarcodeDecoder::configure (int line_, int numBits_, double bitSamples_)
+{
+    line = jlimit (0, TTLDEBUG_PANEL_TOTAL_BITS - 1, line_);
+    numBits = jlimit (1, TTLDEBUG_BARCODE_MAX_BITS, numBits_);
+    bitSamples = jmax (1.0, bitSamples_);
+
+    level = false;
+    receiving = false;
+    reading = TTLBarcodeReading();
+    numErrors = 0;
+}
+
+bool TTLBarcodeDecoder::addEdge (int64 sampleNumber, bool newLevel)
+{
+    // Bits centred before this edge saw the old level.
+    const bool finished = advance (sampleNumber);
+
+    // A barcode starts on a rising edge from idle. After a bad stop bit, the line has to go low first.
+    if (! receiving && newLevel && ! level)
+    {
+        receiving = true;
+        startSample = sampleNumber;
+        nextBit = 0;
+        value = 0;
+    }
+
+    level = newLevel;
+
+    return finished;
+}
+
+bool TTLBarcodeDecoder::advance (int64 sampleNumber)
+{
+    bool finished = false;
+
+    while (receiving && getBitCentre (nextBit) < sampleNumber)
+    {
+        if (nextBit == 0)
+        {
+            // Too short for a start bit; a glitch.
+            if (! level)
+            {
+                receiving = false;
+                numErrors++;
+            }
+        }
+        else if (nextBit <= numBits)
+        {
+            if (level)
+                value |= uint32 (1) << (nextBit - 1);
+        }
+        else
+        {
+            receiving = false;
+
+            if (level)
+            {
+                numErrors++;
+            }
+            else
+            {
+                reading.value = value;
+                reading.startSample = startSample;
+                reading.count++;
+                finished = true;
+            }
+        }
+
+        nextBit++;
+    }
+
+    return finished;
+}
+
+// This is the end of the file.
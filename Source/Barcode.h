@@ -0,0 +1,126 @@
+#ifndef TTLDEBUGBARCODE_H_DEFINED
+#define TTLDEBUGBARCODE_H_DEFINED
+
+#include <ProcessorHeaders.h>
+#include <cmath>
+
+// Longest sync barcode, in data bits.
+#define TTLDEBUG_BARCODE_MAX_BITS 32
+
+namespace TTLDebugTools
+{
+// Sync barcodes on one line of one stream: an incrementing counter, sent at a fixed interval.
+// Each barcode is framed like a UART byte, with the line idling low: one high start bit,
+// the data bits least significant first (high for 1), then at least one low stop bit.
+// Edges are placed from a precomputed schedule, so they're exact to the sample.
+class TTLBarcodeGenerator
+{
+public:
+    // Message thread. Sets up a run; nothing happens until begin().
+    void configure (int line, int numBits, double bitSamples, int64 intervalSamples);
+
+    // Audio thread. Schedules the first barcode, with counter 0, at "firstSample".
+    void begin (int64 firstSample);
+
+    bool isRunning() const
+    {
+        return running;
+    }
+
+    uint64 getLineMask() const
+    {
+        return uint64 (1) << line;
+    }
+
+    // Returns the sample of the next edge.
+    int64 getNextEdgeSample() const
+    {
+        return edgeSamples[nextEdge];
+    }
+
+    // Returns the line's level from the next edge on, and moves on to the edge after it.
+    bool takeEdge();
+
+private:
+    // Fills the edge schedule for the current counter value, starting at "startSample".
+    void scheduleBarcode (int64 startSample);
+
+    int line = 0;
+    int numBits = TTLDEBUG_BARCODE_MAX_BITS;
+    double bitSamples = 1.0;
+    int64 intervalSamples = 1;
+    bool running = false;
+
+    uint32 counter = 0;
+    int64 barcodeStart = 0;
+
+    // Start bit, data bits and stop bit each give at most one edge.
+    int64 edgeSamples[TTLDEBUG_BARCODE_MAX_BITS + 2] = {};
+    bool edgeLevels[TTLDEBUG_BARCODE_MAX_BITS + 2] = {};
+    int numEdges = 0;
+    int nextEdge = 0;
+};
+
+// The latest barcode read off a stream. "count" only ever grows, so the display can tell a repeat of the same value from no news.
+struct TTLBarcodeReading
+{
+    uint32 value = 0;
+    int64 startSample = 0;
+    uint32 count = 0;
+};
+
+// Reads the barcodes TTLBarcodeGenerator writes, one edge at a time.
+// Each bit is sampled at its centre, measured from the start bit's rising edge, using the level the line had there.
+// Only the word being received is kept, so memory doesn't depend on the barcode rate.
+class TTLBarcodeDecoder
+{
+public:
+    // Message thread. Sets up a run and forgets anything half received.
+    void configure (int line, int numBits, double bitSamples);
+
+    int getLine() const
+    {
+        return line;
+    }
+
+    // Audio thread. From "sampleNumber" on, the line is at "level". Returns true if that finished a barcode.
+    bool addEdge (int64 sampleNumber, bool level);
+
+    // Audio thread. Samples every bit centred before "sampleNumber". Returns true if that finished a barcode.
+    bool advance (int64 sampleNumber);
+
+    const TTLBarcodeReading& getReading() const
+    {
+        return reading;
+    }
+
+    // Barcodes dropped because the start bit was too short or the stop bit wasn't low.
+    uint32 getNumErrors() const
+    {
+        return numErrors;
+    }
+
+private:
+    int64 getBitCentre (int bit) const
+    {
+        return startSample + int64 (std::llround ((bit + 0.5) * bitSamples));
+    }
+
+    int line = 0;
+    int numBits = TTLDEBUG_BARCODE_MAX_BITS;
+    double bitSamples = 1.0;
+
+    bool level = false;
+    bool receiving = false;
+    int64 startSample = 0;
+
+    // Bit 0 is the start bit, then the data, then the stop bit.
+    int nextBit = 0;
+    uint32 value = 0;
+
+    TTLBarcodeReading reading;
+    uint32 numErrors = 0;
+};
+} // namespace TTLDebugTools
+
+#endif
@@ -0,0 +1,259 @@
+#include "BitGroups.h"
+#include "PanelBase.h"
+
+using namespace TTLDebugTools;
+
+bool TTLBitGroup::parse (const String& text, String& error)
+{
+    lines.clear();
+    mask = 0;
+
+    StringArray items = StringArray::fromTokens (text, ",", "");
+    items.trim();
+    items.removeEmptyStrings();
+
+    if (items.size() == 0)
+    {
+        error = "no lines in \"" + text + "\"";
+        return false;
+    }
+
+    for (auto item : items)
+    {
+        const String firstText = item.upToFirstOccurrenceOf ("-", false, false).trim();
+        const String lastText = item.containsChar ('-') ? item.fromFirstOccurrenceOf ("-", false, false).trim() : firstText;
+
+        if (! firstText.containsOnly ("0123456789") || ! lastText.containsOnly ("0123456789")
+            || firstText.isEmpty() || lastText.isEmpty())
+        {
+            error = "bad line range \"" + item + "\"";
+            return false;
+        }
+
+        const int first = firstText.getIntValue() - 1;
+        const int last = lastText.getIntValue() - 1;
+        const int step = (last >= first) ? 1 : -1;
+
+        for (int line = first;; line += step)
+        {
+            if (line < 0 || line >= TTLDEBUG_PANEL_TOTAL_BITS)
+            {
+                error = "line " + String (line + 1) + " is out of range";
+                return false;
+            }
+
+            const uint64 bit = uint64 (1) << line;
+
+            if ((mask & bit) != 0)
+            {
+                error = "line " + String (line + 1) + " is used twice";
+                return false;
+            }
+
+            lines.add (line);
+            mask |= bit;
+
+            if (line == last)
+                break;
+        }
+    }
+
+    compile();
+    return true;
+}
+
+bool TTLBitGroup::swapBytes()
+{
+    const int numLines = lines.size();
+
+    if (numLines == 0 || numLines % 8 != 0)
+        return false;
+
+    for (int first = 0, last = numLines / 8 - 1; first < last; first++, last--)
+    {
+        for (int bit = 0; bit < 8; bit++)
+            lines.swap (first * 8 + bit, last * 8 + bit);
+    }
+
+    compile();
+    return true;
+}
+
+// The per-line loops only run here, once per group.
+void TTLBitGroup::compile()
+{
+    const int numLines = lines.size();
+
+    valueMask = numLines >= 64 ? ~uint64 (0) : (uint64 (1) << numLines) - 1;
+    shift = numLines > 0 ? lines[0] : 0;
+
+    extractTables = ByteTables();
+    depositTables = ByteTables();
+
+    bool contiguous = true;
+
+    for (int groupBit = 1; groupBit < numLines; groupBit++)
+        contiguous = contiguous && lines[groupBit] == lines[0] + groupBit;
+
+    if (contiguous)
+    {
+        layout = Contiguous;
+        return;
+    }
+
+    layout = Scattered;
+
+    // Word byte to group value.
+    for (int byte = 0; byte < 8; byte++)
+    {
+        if (((mask >> (byte * 8)) & 0xff) == 0)
+            continue;
+
+        extractTables.bytes.push_back (byte);
+
+        for (int value = 0; value < 256; value++)
+        {
+            uint64 entry = 0;
+
+            for (int groupBit = 0; groupBit < numLines; groupBit++)
+            {
+                if (lines[groupBit] / 8 == byte && ((value >> (lines[groupBit] % 8)) & 1) != 0)
+                    entry |= uint64 (1) << groupBit;
+            }
+
+            extractTables.entries.push_back (entry);
+        }
+    }
+
+    // Group value byte to word.
+    for (int byte = 0; byte * 8 < numLines; byte++)
+    {
+        depositTables.bytes.push_back (byte);
+
+        for (int value = 0; value < 256; value++)
+        {
+            uint64 entry = 0;
+
+            for (int bit = 0; bit < 8 && byte * 8 + bit < numLines; bit++)
+            {
+                if (((value >> bit) & 1) != 0)
+                    entry |= uint64 (1) << lines[byte * 8 + bit];
+            }
+
+            depositTables.entries.push_back (entry);
+        }
+    }
+}
+
+void TTLBitRouter::clear()
+{
+    numActiveBytes = 0;
+    inputMask = 0;
+    outputMask = 0;
+}
+
+bool TTLBitRouter::parse (const String& text, Logic logic_, String& error)
+{
+    clear();
+    logic = logic_;
+
+    std::vector<Mapping> mappings;
+
+    StringArray routeTexts = StringArray::fromTokens (text, ";", "");
+    routeTexts.trim();
+    routeTexts.removeEmptyStrings();
+
+    for (auto routeText : routeTexts)
+    {
+        if (! routeText.containsChar ('>'))
+        {
+            error = "no \">\" in \"" + routeText + "\"";
+            return false;
+        }
+
+        String outputText = routeText.fromFirstOccurrenceOf (">", false, false).trim();
+        const bool inverted = outputText.startsWithChar ('!');
+
+        if (inverted)
+            outputText = outputText.substring (1);
+
+        TTLBitGroup inputs;
+        TTLBitGroup outputs;
+
+        if (! inputs.parse (routeText.upToFirstOccurrenceOf (">", false, false), error) || ! outputs.parse (outputText, error))
+            return false;
+
+        if (inputs.getNumLines() != outputs.getNumLines())
+        {
+            error = "\"" + routeText + "\" maps " + String (inputs.getNumLines()) + " lines to " + String (outputs.getNumLines());
+            return false;
+        }
+
+        for (int index = 0; index < inputs.getNumLines(); index++)
+            mappings.push_back ({ inputs.getLine (index), outputs.getLine (index), inverted });
+    }
+
+    for (auto& mapping : mappings)
+    {
+        inputMask |= uint64 (1) << mapping.input;
+        outputMask |= uint64 (1) << mapping.output;
+    }
+
+    // Fill a table for every input byte that feeds something.
+    for (int byte = 0; byte < 8; byte++)
+    {
+        if (((inputMask >> (byte * 8)) & 0xff) == 0)
+            continue;
+
+        activeBytes[numActiveBytes++] = byte;
+
+        for (int value = 0; value < 256; value++)
+        {
+            uint64 entry = 0;
+
+            for (auto& mapping : mappings)
+            {
+                if (mapping.input / 8 != byte)
+                    continue;
+
+                const bool level = (((value >> (mapping.input % 8)) & 1) != 0) != mapping.inverted;
+
+                // And tables collect the terms that are false.
+                if (level != (logic == And))
+                    entry = (logic == Xor) ? (entry ^ (uint64 (1) << mapping.output)) : (entry | (uint64 (1) << mapping.output));
+            }
+
+            tables[byte][value] = entry;
+        }
+    }
+
+    return true;
+}
+
+bool TTLDebugTools::parseTTLWord (const String& text, uint64& word)
+{
+    const String trimmed = text.trim().toLowerCase();
+    const bool isHex = trimmed.startsWith ("0x");
+    const String digits = isHex ? trimmed.substring (2) : trimmed;
+    const uint64 radix = isHex ? 16 : 10;
+
+    if (digits.isEmpty() || ! digits.containsOnly (isHex ? "0123456789abcdef" : "0123456789"))
+        return false;
+
+    // Parse by hand; JUCE's integer parsers stop at int64.
+    uint64 value = 0;
+
+    for (int index = 0; index < digits.length(); index++)
+    {
+        const char digit = char (digits[index]);
+        const uint64 digitValue = uint64 (digit <= '9' ? digit - '0' : digit - 'a' + 10);
+
+        if (value > (~uint64 (0) - digitValue) / radix)
+            return false;
+
+        value = value * radix + digitValue;
+    }
+
+    word = value;
+    return true;
+}
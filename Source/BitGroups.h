@@ -0,0 +1,190 @@
+#ifndef TTLDEBUGBITGROUPS_H_DEFINED
+#define TTLDEBUGBITGROUPS_H_DEFINED
+
+#include <ProcessorHeaders.h>
+
+namespace TTLDebugTools
+{
+/**
+		An ordered set of TTL lines treated as one word.
+
+		Bit 0 of the group value lives on lines[0], bit 1 on lines[1], and so on.
+		Lines are zero-based here; text specifications use the one-based numbers
+		printed on the bit buttons.
+
+		Runs of consecutive lines in order (the usual 8, 16 or 32-bit banks) are
+		a shift and a mask. Anything else goes through byte lookup tables built
+		when the group is parsed. Either way there's no per-line loop.
+	*/
+class TTLBitGroup
+{
+public:
+    /** Parses a line list such as "1-8", "8-1" (reversed) or "1,3,5,7".
+		Returns false and sets "error" if the text is malformed. */
+    bool parse (const String& text, String& error);
+
+    /** Swaps the byte order, so the first eight listed lines become the most significant byte.
+        Bits keep their order within each byte. Returns false, changing nothing, unless the group is a whole number of bytes. */
+    bool swapBytes();
+
+    /** Number of lines in the group */
+    int getNumLines() const
+    {
+        return lines.size();
+    }
+
+    /** Zero-based line that holds the given group bit */
+    int getLine (int groupBit) const
+    {
+        return lines[groupBit];
+    }
+
+    /** All lines touched by this group, as a mask */
+    uint64 getMask() const
+    {
+        return mask;
+    }
+
+    /** Spreads a group value over the group's lines. Bits outside the group are zero. */
+    uint64 deposit (uint64 value) const
+    {
+        switch (layout)
+        {
+            case Contiguous:
+                return (value & valueMask) << shift;
+            default:
+                return lookUp (depositTables, value & valueMask);
+        }
+    }
+
+    /** Gathers the group's lines from a TTL word into a group value. */
+    uint64 extract (uint64 word) const
+    {
+        switch (layout)
+        {
+            case Contiguous:
+                return (word >> shift) & valueMask;
+            default:
+                return lookUp (extractTables, word & mask);
+        }
+    }
+
+private:
+    enum Layout
+    {
+        Contiguous,
+        Scattered
+    };
+
+    // 256 entries for each source byte that matters. Entry "value" holds what that byte contributes to the result.
+    struct ByteTables
+    {
+        std::vector<uint64> entries;
+        std::vector<int> bytes;
+    };
+
+    /** Picks the layout, and builds the tables if it's scattered */
+    void compile();
+
+    static uint64 lookUp (const ByteTables& tables, uint64 source)
+    {
+        uint64 result = 0;
+
+        for (size_t index = 0; index < tables.bytes.size(); index++)
+            result |= tables.entries[index * 256 + ((source >> (tables.bytes[index] * 8)) & 0xff)];
+
+        return result;
+    }
+
+    Array<int> lines;
+    uint64 mask = 0;
+
+    Layout layout = Contiguous;
+    int shift = 0;
+    uint64 valueMask = 0;
+    ByteTables extractTables;
+    ByteTables depositTables;
+};
+
+/**
+		Maps input TTL lines to output TTL lines, compiled to byte lookup tables.
+
+		The routing text is "inputs > outputs; ..." with line lists as in
+		TTLBitGroup, e.g. "1-4 > 9-12; 5 > !13". A "!" inverts the outputs of
+		one mapping. Outputs fed by several inputs combine them with the
+		chosen logic. Routing a word costs one lookup per input byte in use,
+		however many lines are mapped.
+	*/
+class TTLBitRouter
+{
+public:
+    enum Logic
+    {
+        Or = 0,
+        And,
+        Xor
+    };
+
+    /** Parses and compiles a routing. Returns false and sets "error" if the text is malformed;
+		the router is then left empty. Empty text gives an empty router. */
+    bool parse (const String& text, Logic logic, String& error);
+
+    /** True if nothing is routed */
+    bool isEmpty() const
+    {
+        return outputMask == 0;
+    }
+
+    /** Lines that drive an output */
+    uint64 getInputMask() const
+    {
+        return inputMask;
+    }
+
+    /** Lines driven by the router */
+    uint64 getOutputMask() const
+    {
+        return outputMask;
+    }
+
+    /** Returns the output lines for an input word. Bits outside getOutputMask() are zero. */
+    uint64 route (uint64 inputWord) const
+    {
+        uint64 word = 0;
+
+        for (int index = 0; index < numActiveBytes; index++)
+        {
+            const int byte = activeBytes[index];
+            const uint64 entry = tables[byte][(inputWord >> (byte * 8)) & 0xff];
+
+            word = (logic == Xor) ? (word ^ entry) : (word | entry);
+        }
+
+        // And is computed as "not any input false"; the tables hold the inverted terms.
+        return logic == And ? (~word & outputMask) : word;
+    }
+
+private:
+    struct Mapping
+    {
+        int input;
+        int output;
+        bool inverted;
+    };
+
+    void clear();
+
+    // One table per input byte. Entry "value" holds what that byte contributes to the output word.
+    uint64 tables[8][256];
+    int activeBytes[8] = {};
+    int numActiveBytes = 0;
+    uint64 inputMask = 0;
+    uint64 outputMask = 0;
+    Logic logic = Or;
+};
+
+/** Parses one unsigned word, in decimal or with a "0x" prefix. Returns false if malformed. */
+bool parseTTLWord (const String& text, uint64& word);
+} // namespace TTLDebugTools
+
+#endif
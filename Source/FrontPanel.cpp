@@ -0,0 +1,382 @@
+#include "FrontPanel.h"
+#include <cmath>
+
+using namespace TTLDebugTools;
+
+// Front panel (display).
+
+TTLFrontPanel::TTLFrontPanel() : TTLPanelBase ("TTL Display Panel", false)
+{
+    keepsTransitionHistory = true;
+}
+
+TTLFrontPanel::~TTLFrontPanel()
+{
+}
+
+void TTLFrontPanel::registerParameters()
+{
+    TTLPanelBase::registerParameters();
+
+    // Only read by the editor.
+    addStringParameter (Parameter::PROCESSOR_SCOPE,
+                        "word_groups",
+                        "Groups",
+                        "Lines shown as one value, lettered A, B, ... in order, e.g. \"1-8; 9-24\"; empty for none",
+                        "",
+                        false);
+
+    addBooleanParameter (Parameter::PROCESSOR_SCOPE,
+                         "log_transitions",
+                         "Log",
+                         "Write every input transition to a binary log in the recording directory",
+                         false,
+                         true);
+
+    addFloatParameter (Parameter::PROCESSOR_SCOPE,
+                       "debounce",
+                       "Debounce",
+                       "Ignore edges on a line that don't stay put for this long; 0 to show every edge",
+                       "ms",
+                       0.0f,
+                       0.0f,
+                       1000.0f,
+                       0.01f,
+                       true);
+
+    // Decoder settings are read when acquisition starts. They should match the sending panel's barcode settings.
+    addIntParameter (Parameter::PROCESSOR_SCOPE,
+                     "decode_line",
+                     "Decode",
+                     "Input line to decode sync barcodes from; 0 for none",
+                     0,
+                     0,
+                     TTLDEBUG_PANEL_TOTAL_BITS,
+                     true);
+
+    addIntParameter (Parameter::PROCESSOR_SCOPE,
+                     "decode_bits",
+                     "Bits",
+                     "Data bits in each barcode",
+                     32,
+                     1,
+                     TTLDEBUG_BARCODE_MAX_BITS,
+                     true);
+
+    addFloatParameter (Parameter::PROCESSOR_SCOPE,
+                       "decode_bit_ms",
+                       "Bit",
+                       "Length of one barcode bit",
+                       "ms",
+                       20.0f,
+                       0.1f,
+                       1000.0f,
+                       0.1f,
+                       true);
+}
+
+void TTLFrontPanel::updateSettings()
+{
+    TTLPanelBase::updateSettings();
+
+    lineStats.assign (streamStates.size() * TTLDEBUG_PANEL_TOTAL_BITS, TTLLineStats());
+    statsSnapshot.resize (lineStats.size());
+
+    debounce.assign (streamStates.size(), LineDebounce());
+    parameterValueChanged (getParameter ("debounce"));
+
+    // Decoded barcodes go downstream as text, so a record node can store them alongside the data.
+    barcodeChannels.assign (streamStates.size(), nullptr);
+
+    for (auto& state : streamStates)
+    {
+        EventChannel* barcodeChan;
+        EventChannel::Settings barcodeChannelSettings {
+            EventChannel::Type::TEXT,
+            getName() + " barcodes",
+            "Sync barcode values decoded from the input, at the sample of their start bit.",
+            "displaypanel.barcode",
+            getDataStream (state.streamId)
+        };
+
+        barcodeChan = new EventChannel (barcodeChannelSettings);
+        barcodeChan->addProcessor (this);
+        eventChannels.add (barcodeChan);
+
+        barcodeChannels[state.slot] = eventChannels.getLast();
+    }
+}
+
+void TTLFrontPanel::parameterValueChanged (Parameter* parameter)
+{
+    if (parameter == nullptr)
+        return;
+
+    if (parameter->getName() == "debounce")
+    {
+        debounceMs = jmax (0.0, double (parameter->getValue()));
+        updateDebounce();
+    }
+    else
+    {
+        TTLPanelBase::parameterValueChanged (parameter);
+    }
+}
+
+void TTLFrontPanel::updateDebounce()
+{
+    for (auto& state : streamStates)
+        debounce[state.slot].minStableSamples = int64 (std::llround (debounceMs * 0.001 * state.sampleRate));
+}
+
+void TTLFrontPanel::configureDecoder()
+{
+    decoders.clear();
+
+    for (auto& state : streamStates)
+        state.barcode = TTLBarcodeReading();
+
+    const int line = int (getParameter ("decode_line")->getValue());
+
+    if (line <= 0)
+        return;
+
+    const int numBits = int (getParameter ("decode_bits")->getValue());
+    const double bitMs = double (getParameter ("decode_bit_ms")->getValue());
+
+    decoders.resize (streamStates.size());
+
+    for (auto& state : streamStates)
+        decoders[state.slot].configure (line - 1, numBits, bitMs * 0.001 * state.sampleRate);
+}
+
+// The event carries the start bit's sample. It's slotted into the block at that sample,
+// or at the block's start if the barcode began in an earlier block.
+void TTLFrontPanel::reportBarcode (TTLStreamState& state)
+{
+    state.barcode = decoders[state.slot].getReading();
+
+    if (state.slot < int (barcodeChannels.size()) && barcodeChannels[state.slot] != nullptr)
+    {
+        addEvent (TextEvent::createTextEvent (barcodeChannels[state.slot],
+                                              state.barcode.startSample,
+                                              String (state.barcode.value)),
+                  getBlockOffset (state, state.barcode.startSample));
+    }
+}
+
+bool TTLFrontPanel::startAcquisition()
+{
+    TTLPanelBase::startAcquisition();
+
+    std::fill (lineStats.begin(), lineStats.end(), TTLLineStats());
+
+    configureDecoder();
+
+    Parameter* logParam = getParameter ("log_transitions");
+
+    if (logParam != nullptr && bool (logParam->getValue()))
+    {
+        const String fileName = getName().replace (" ", "_") + "_" + String (getNodeId()) + "_"
+                                + Time::getCurrentTime().formatted ("%Y-%m-%d_%H-%M-%S") + ".ttllog";
+
+        transitionLog = std::make_unique<TTLTransitionLogWriter> (CoreServices::getRecordingParentDirectory().getChildFile (fileName));
+
+        Result opened = transitionLog->open();
+
+        if (opened.failed())
+        {
+            LOGE (getName(), ": transition log not started: ", opened.getErrorMessage());
+            CoreServices::sendStatusMessage (getName() + ": transition log not started");
+            transitionLog.reset();
+        }
+        else
+        {
+            LOGC (getName(), ": logging transitions to ", transitionLog->getFile().getFullPathName());
+        }
+    }
+
+    return true;
+}
+
+bool TTLFrontPanel::stopAcquisition()
+{
+    // Edges still waiting to be confirmed when acquisition stops never were.
+    for (auto& lines : debounce)
+        lines.pendingMask = 0;
+
+    if (transitionLog != nullptr)
+    {
+        transitionLog->close();
+        transitionLog.reset();
+    }
+
+    for (const auto& decoder : decoders)
+    {
+        if (decoder.getNumErrors() > 0)
+            LOGC (getName(), ": ", decoder.getNumErrors(), " malformed barcodes on a stream");
+    }
+
+    return TTLPanelBase::stopAcquisition();
+}
+
+void TTLFrontPanel::process (AudioBuffer<float>& buffer)
+{
+    TTLDEBUG_INSTRUMENT (beginInstrumentedBlock();)
+
+    TTLPanelBase::process (buffer);
+
+    if (statsRequested.exchange (false, std::memory_order_acquire))
+    {
+        std::copy (lineStats.begin(), lineStats.end(), statsSnapshot.getWriteBuffer());
+        statsSnapshot.publish();
+    }
+
+    TTLDEBUG_INSTRUMENT (endInstrumentedBlock();)
+}
+
+void TTLFrontPanel::acceptEdge (TTLStreamState& state, int line, bool level, int64 sampleNumber)
+{
+    TTLPanelBase::applyInputEdge (state, line, level, sampleNumber);
+
+    lineStats[state.slot * TTLDEBUG_PANEL_TOTAL_BITS + line].addEdge (sampleNumber, level);
+
+    if (transitionLog != nullptr)
+        transitionLog->push ({ sampleNumber, state.currentWord, state.streamId, {} });
+
+    if (state.slot < int (decoders.size()) && decoders[state.slot].getLine() == line)
+    {
+        if (decoders[state.slot].addEdge (sampleNumber, level))
+            reportBarcode (state);
+    }
+}
+
+// A bounce that returns to the accepted level before the debounce time is up cancels the pending edge,
+// so a burst of chatter costs nothing downstream of here.
+void TTLFrontPanel::applyInputEdge (TTLStreamState& state, int line, bool level, int64 sampleNumber)
+{
+    LineDebounce& lines = debounce[state.slot];
+
+    if (lines.minStableSamples <= 0 && lines.pendingMask == 0)
+    {
+        acceptEdge (state, line, level, sampleNumber);
+        return;
+    }
+
+    // Everything that settled before this edge goes first, so edges are still accepted in sample order.
+    advanceStream (state, sampleNumber);
+
+    const uint64 bit = uint64 (1) << line;
+    const bool acceptedLevel = (state.currentWord & bit) != 0;
+
+    if ((lines.pendingMask & bit) != 0)
+    {
+        if (level == acceptedLevel)
+            lines.pendingMask &= ~bit;
+    }
+    else if (level != acceptedLevel)
+    {
+        lines.pendingMask |= bit;
+        lines.pendingSamples[line] = sampleNumber;
+    }
+}
+
+// Pending edges are accepted at the sample they arrived, in arrival order; they all wait the same time.
+void TTLFrontPanel::advanceStream (TTLStreamState& state, int64 sampleNumber)
+{
+    LineDebounce& lines = debounce[state.slot];
+
+    while (lines.pendingMask != 0)
+    {
+        int earliest = -1;
+
+        for (uint64 pending = lines.pendingMask; pending != 0; pending &= pending - 1)
+        {
+            const int line = getLowestSetBit (pending);
+
+            if (earliest < 0 || lines.pendingSamples[line] < lines.pendingSamples[earliest])
+                earliest = line;
+        }
+
+        if (lines.pendingSamples[earliest] + lines.minStableSamples >= sampleNumber)
+            break;
+
+        lines.pendingMask &= ~(uint64 (1) << earliest);
+
+        acceptEdge (state, earliest, (state.currentWord & (uint64 (1) << earliest)) == 0, lines.pendingSamples[earliest]);
+    }
+
+    // Bits can only be read up to an edge that's still waiting, since it may yet be accepted.
+    // Barcodes ending in zeros finish here, without another edge.
+    if (state.slot < int (decoders.size()))
+    {
+        TTLBarcodeDecoder& decoder = decoders[state.slot];
+        int64 decodedUntil = sampleNumber;
+
+        if ((lines.pendingMask >> decoder.getLine()) & 1)
+            decodedUntil = jmin (decodedUntil, lines.pendingSamples[decoder.getLine()]);
+
+        if (decoder.advance (decodedUntil))
+            reportBarcode (state);
+    }
+
+    TTLPanelBase::advanceStream (state, sampleNumber);
+}
+
+String TTLFrontPanel::describeLine (uint16 streamId, int line)
+{
+    // While acquiring, ask the audio thread for fresh numbers; they'll be there next time.
+    // While stopped, nothing else writes the snapshot, so publish the last run's numbers from here.
+    if (CoreServices::getAcquisitionStatus())
+    {
+        statsRequested.store (true, std::memory_order_release);
+    }
+    else if (statsSnapshot.size() == lineStats.size())
+    {
+        std::copy (lineStats.begin(), lineStats.end(), statsSnapshot.getWriteBuffer());
+        statsSnapshot.publish();
+    }
+
+    statsSnapshot.pull();
+
+    TTLStreamState* state = getStreamState (streamId);
+
+    if (state == nullptr || line < 0 || line >= TTLDEBUG_PANEL_TOTAL_BITS || statsSnapshot.size() != lineStats.size())
+        return String();
+
+    const TTLLineStats& stats = statsSnapshot.getReadBuffer()[state->slot * TTLDEBUG_PANEL_TOTAL_BITS + line];
+
+    if (stats.numEdges < 2)
+        return String();
+
+    String description;
+    const char* levelNames[TTLLineStats::NumLevels] = { "Low", "High" };
+
+    const double spanSeconds = double (stats.lastEdgeSample - stats.firstEdgeSample) / state->sampleRate;
+
+    if (spanSeconds > 0.0)
+        description << String ((stats.numEdges - 1) / spanSeconds, 2) << " edges/s\n";
+
+    for (int level = 0; level < TTLLineStats::NumLevels; level++)
+    {
+        if (stats.numPeriods[level] == 0)
+            continue;
+
+        description << levelNames[level] << " (samples): min " << String (stats.minDuration[level])
+                    << ", mean " << String (double (stats.totalDuration[level]) / stats.numPeriods[level], 1)
+                    << ", max " << String (stats.maxDuration[level]) << "\n";
+    }
+
+    for (int bin = 0; bin < TTLDEBUG_PANEL_STATS_HISTOGRAM_BINS; bin++)
+    {
+        if (stats.widthHistogram[bin] == 0)
+            continue;
+
+        description << "Width " << String (int64 (1) << bin) << "-" << String ((int64 (2) << bin) - 1)
+                    << ": " << String (stats.widthHistogram[bin]) << "\n";
+    }
+
+    return description.trimEnd();
+}
+
+// This is the end of the file.
@@ -0,0 +1,153 @@
+#ifndef TTLDEBUGFRONTPANEL_H_DEFINED
+#define TTLDEBUGFRONTPANEL_H_DEFINED
+
+#include "PanelBase.h"
+#include "TransitionLog.h"
+
+// Pulse-width histogram bins. Bin "n" counts high pulses of 2^n to 2^(n+1)-1 samples.
+#define TTLDEBUG_PANEL_STATS_HISTOGRAM_BINS 32
+
+namespace TTLDebugTools
+{
+// Running statistics for one input line. Constant size, and O(1) to update.
+struct TTLLineStats
+{
+    int64 firstEdgeSample = -1;
+    int64 lastEdgeSample = -1;
+    uint32 numEdges = 0;
+
+    // Index into the per-level arrays.
+    enum Level
+    {
+        Low = 0,
+        High = 1,
+        NumLevels
+    };
+
+    // Durations, in samples, of completed low and high periods.
+    int64 minDuration[NumLevels] = { 0, 0 };
+    int64 maxDuration[NumLevels] = { 0, 0 };
+    int64 totalDuration[NumLevels] = { 0, 0 };
+    uint32 numPeriods[NumLevels] = { 0, 0 };
+
+    // High pulse widths, log2-binned.
+    uint32 widthHistogram[TTLDEBUG_PANEL_STATS_HISTOGRAM_BINS] = {};
+
+    // Records an edge. The period it ends had the opposite level.
+    void addEdge (int64 sampleNumber, bool newState)
+    {
+        if (lastEdgeSample >= 0)
+        {
+            const Level level = newState ? Low : High;
+            const int64 duration = sampleNumber - lastEdgeSample;
+
+            if (numPeriods[level] == 0 || duration < minDuration[level])
+                minDuration[level] = duration;
+
+            if (duration > maxDuration[level])
+                maxDuration[level] = duration;
+
+            totalDuration[level] += duration;
+            numPeriods[level]++;
+
+            if (level == High && duration > 0)
+                widthHistogram[jmin (TTLDEBUG_PANEL_STATS_HISTOGRAM_BINS - 1, findHighestSetBit (uint32 (jmin (duration, int64 (UINT32_MAX)))))]++;
+        }
+        else
+        {
+            firstEdgeSample = sampleNumber;
+        }
+
+        lastEdgeSample = sampleNumber;
+        numEdges++;
+    }
+};
+
+/** 
+	
+		Creates an array of indicators to show the state of individual TTL lines
+		
+	*/
+class TTLFrontPanel : public TTLPanelBase
+{
+public:
+    /** Constructor */
+    TTLFrontPanel();
+
+    /** Destructor*/
+    ~TTLFrontPanel();
+
+    /** Adds the transition log, debounce and barcode decoder settings to the shared parameters */
+    void registerParameters() override;
+
+    /** Sizes the statistics for the current streams, and adds a text channel per stream for decoded barcodes */
+    void updateSettings() override;
+
+    /** Clears the statistics, sets up the barcode decoder, and opens the transition log if it's enabled */
+    bool startAcquisition() override;
+
+    /** Closes the transition log */
+    bool stopAcquisition() override;
+
+    /** Runs the base processing loop, then publishes statistics if the editor asked for them */
+    void process (AudioBuffer<float>& buffer) override;
+
+    /** Picks up the debounce time */
+    void parameterValueChanged (Parameter* parameter) override;
+
+    /** Message thread. Describes a line's statistics, from the latest published snapshot. */
+    String describeLine (uint16 streamId, int line) override;
+
+protected:
+    /** Holds the edge back until the line has been stable for the debounce time, or accepts it straight away if that's 0 */
+    void applyInputEdge (TTLStreamState& state, int line, bool level, int64 sampleNumber) override;
+
+    /** Accepts debounced edges that have been stable since before "sampleNumber" */
+    void advanceStream (TTLStreamState& state, int64 sampleNumber) override;
+
+private:
+    // At most one unconfirmed edge per line. It's the opposite of the line's accepted level, so only its sample is stored.
+    struct LineDebounce
+    {
+        uint64 pendingMask = 0;
+        int64 pendingSamples[TTLDEBUG_PANEL_TOTAL_BITS] = {};
+        int64 minStableSamples = 0;
+    };
+
+    /** Updates the word, statistics, log and barcode decoder for an edge that got through the debounce */
+    void acceptEdge (TTLStreamState& state, int line, bool level, int64 sampleNumber);
+
+    /** Converts the debounce time to samples for every stream */
+    void updateDebounce();
+
+    /** Builds a barcode decoder per stream from the decode settings */
+    void configureDecoder();
+
+    /** Shows the decoder's latest reading, and sends it downstream as a text event at the sample of its start bit */
+    void reportBarcode (TTLStreamState& state);
+
+    // Per stream slot. Only touched by the audio thread while running.
+    std::vector<LineDebounce> debounce;
+    double debounceMs = 0.0;
+
+    // Per stream slot, or empty when decoding is off. Only touched by the audio thread while running.
+    std::vector<TTLBarcodeDecoder> decoders;
+
+    // Per stream slot. Rebuilt in updateSettings(); the processor owns the channels.
+    std::vector<EventChannel*> barcodeChannels;
+
+    // TTLDEBUG_PANEL_TOTAL_BITS records per stream slot. Only touched by the audio thread.
+    std::vector<TTLLineStats> lineStats;
+
+    // Published only when the editor asks, since the editor only looks at them on hover.
+    TripleBuffer<TTLLineStats> statsSnapshot;
+    std::atomic<bool> statsRequested { false };
+
+    // Only exists between startAcquisition() and stopAcquisition(), when logging is enabled.
+    std::unique_ptr<TTLTransitionLogWriter> transitionLog;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TTLFrontPanel);
+};
+} // namespace TTLDebugTools
+
+#endif
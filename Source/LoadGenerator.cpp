@@ -0,0 +1,107 @@
+#include "LoadGenerator.h"
+#include "PanelBase.h"
+#include <cmath>
+
+using namespace TTLDebugTools;
+
+// One splitmix64 step, so that nearby inputs still give unrelated outputs.
+static uint64 splitMix (uint64 value)
+{
+    uint64 mixed = value + 0x9e3779b97f4a7c15ULL;
+    mixed = (mixed ^ (mixed >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    mixed = (mixed ^ (mixed >> 27)) * 0x94d049bb133111ebULL;
+    return mixed ^ (mixed >> 31);
+}
+
+void TTLLoadGenerator::configure (const Settings& settings_, int64 seed, uint64 stream)
+{
+    settings = settings_;
+    settings.intervalSamples = jmax (1.0, settings.intervalSamples);
+    running = false;
+    nextEdgeSample = INT64_MAX;
+
+    // The seed's bits are mixed as they are, so every int64 seed, negative ones included, gives its own sequence.
+    // The stream goes in after the seed is mixed, so seed 1 stream 0 and seed 0 stream 64 are unrelated.
+    // xorshift needs a non-zero state.
+    const uint64 mixedSeed = splitMix (uint64 (seed));
+    randomState = splitMix (mixedSeed + stream) | 1;
+}
+
+uint64 TTLLoadGenerator::nextRandom()
+{
+    randomState ^= randomState >> 12;
+    randomState ^= randomState << 25;
+    randomState ^= randomState >> 27;
+
+    return randomState * 0x2545f4914f6cdd1dULL;
+}
+
+int64 TTLLoadGenerator::scheduleAfter (int64 sampleNumber)
+{
+    double interval = settings.intervalSamples;
+
+    if (settings.timing == Poisson)
+    {
+        // Exponential, from a uniform in (0, 1].
+        const double uniform = double ((nextRandom() >> 11) + 1) * (1.0 / 9007199254740992.0);
+        interval = -std::log (uniform) * settings.intervalSamples;
+    }
+
+    return skipGap (sampleNumber + jmax (int64 (1), int64 (std::llround (interval))));
+}
+
+int64 TTLLoadGenerator::skipGap (int64 sampleNumber) const
+{
+    if (settings.gapSamples <= 0)
+        return sampleNumber;
+
+    const int64 cycle = settings.burstSamples + settings.gapSamples;
+    const int64 phase = (sampleNumber - origin) % cycle;
+
+    return phase < settings.burstSamples ? sampleNumber : sampleNumber + cycle - phase;
+}
+
+void TTLLoadGenerator::begin (int64 firstSample)
+{
+    origin = firstSample;
+    running = true;
+    nextEdgeSample = INT64_MAX;
+
+    for (uint64 lines = settings.lineMask; lines != 0; lines &= lines - 1)
+    {
+        const int line = getLowestSetBit (lines);
+
+        // Periodic lines start at a random phase, so they don't all switch on the same sample.
+        if (settings.timing == Periodic)
+            edgeSamples[line] = skipGap (firstSample + int64 (nextRandom() % uint64 (jmax (int64 (1), int64 (settings.intervalSamples)))));
+        else
+            edgeSamples[line] = scheduleAfter (firstSample);
+
+        nextEdgeSample = jmin (nextEdgeSample, edgeSamples[line]);
+    }
+}
+
+uint64 TTLLoadGenerator::takeEdges()
+{
+    const int64 now = nextEdgeSample;
+    uint64 changed = 0;
+
+    nextEdgeSample = INT64_MAX;
+
+    for (uint64 lines = settings.lineMask; lines != 0; lines &= lines - 1)
+    {
+        const int line = getLowestSetBit (lines);
+
+        if (edgeSamples[line] == now)
+        {
+            changed |= uint64 (1) << line;
+            edgeSamples[line] = scheduleAfter (now);
+        }
+
+        nextEdgeSample = jmin (nextEdgeSample, edgeSamples[line]);
+    }
+
+    return changed;
+}
+
+// This is the end of the file.
@@ -0,0 +1,81 @@
+#ifndef TTLDEBUGLOADGENERATOR_H_DEFINED
+#define TTLDEBUGLOADGENERATOR_H_DEFINED
+
+#include <ProcessorHeaders.h>
+
+// Lines one generator can drive: one per bit of the line mask.
+#define TTLDEBUG_LOAD_MAX_LINES 64
+
+namespace TTLDebugTools
+{
+// Synthetic edge traffic for one stream, for stress-testing whatever is downstream.
+// Edge times depend only on the settings, the seed and the first sample, never on block size, so runs are reproducible.
+// Storage is fixed and nothing is allocated while running.
+class TTLLoadGenerator
+{
+public:
+    enum Timing
+    {
+        Periodic = 0,
+        Poisson
+    };
+
+    struct Settings
+    {
+        Timing timing = Periodic;
+        uint64 lineMask = 0;
+
+        // Mean interval between two edges on one line.
+        double intervalSamples = 1.0;
+
+        // Edges only happen during the first "burstSamples" of every "burstSamples + gapSamples". No gap means no bursts.
+        int64 burstSamples = 0;
+        int64 gapSamples = 0;
+    };
+
+    // Message thread. Sets up a run; nothing happens until begin().
+    // Every "stream" gets its own sequence from the same seed.
+    void configure (const Settings& settings, int64 seed, uint64 stream);
+
+    // Audio thread. Schedules the first edge on every line, from "firstSample" on.
+    void begin (int64 firstSample);
+
+    bool isRunning() const
+    {
+        return running;
+    }
+
+    uint64 getLineMask() const
+    {
+        return settings.lineMask;
+    }
+
+    // Returns the sample of the next edge on any line.
+    int64 getNextEdgeSample() const
+    {
+        return nextEdgeSample;
+    }
+
+    // Returns the lines that change at getNextEdgeSample(), and schedules their following edges.
+    uint64 takeEdges();
+
+private:
+    // xorshift64*; cheap enough to call once per edge.
+    uint64 nextRandom();
+
+    // Returns the sample of the edge that follows one at "sampleNumber", pushed out of any gap.
+    int64 scheduleAfter (int64 sampleNumber);
+
+    // Moves a sample that falls in a gap to the start of the next burst.
+    int64 skipGap (int64 sampleNumber) const;
+
+    Settings settings;
+    uint64 randomState = 1;
+    bool running = false;
+    int64 origin = 0;
+    int64 nextEdgeSample = INT64_MAX;
+    int64 edgeSamples[TTLDEBUG_LOAD_MAX_LINES] = {};
+};
+} // namespace TTLDebugTools
+
+#endif
@@ -0,0 +1,102 @@
+#ifndef TTLDEBUGLOCKFREEFIFO_H_DEFINED
+#define TTLDEBUGLOCKFREEFIFO_H_DEFINED
+
+#include <atomic>
+#include <vector>
+
+namespace TTLDebugTools
+{
+/**
+		Bounded single-producer/single-consumer FIFO.
+
+		Storage is allocated by resize() and never touched again, so push() and
+		pop() are wait-free and allocation-free. resize() must only be called
+		while neither side is active.
+	*/
+template <typename ElementType>
+class LockFreeFifo
+{
+public:
+    LockFreeFifo() = default;
+
+    // Reallocates storage for "capacity" elements and empties the FIFO. Not thread-safe.
+    void resize (size_t capacity)
+    {
+        buffer.assign (capacity + 1, ElementType());
+        readIndex.store (0, std::memory_order_relaxed);
+        writeIndex.store (0, std::memory_order_relaxed);
+    }
+
+    size_t getCapacity() const
+    {
+        return buffer.empty() ? 0 : buffer.size() - 1;
+    }
+
+    size_t getNumReady() const
+    {
+        const size_t writePos = writeIndex.load (std::memory_order_acquire);
+        const size_t readPos = readIndex.load (std::memory_order_acquire);
+
+        return writePos >= readPos ? writePos - readPos : buffer.size() - readPos + writePos;
+    }
+
+    // Producer side. Returns false (and drops the element) if the FIFO is full.
+    bool push (const ElementType& element)
+    {
+        if (buffer.empty())
+            return false;
+
+        const size_t writePos = writeIndex.load (std::memory_order_relaxed);
+        const size_t nextPos = advance (writePos);
+
+        if (nextPos == readIndex.load (std::memory_order_acquire))
+            return false;
+
+        buffer[writePos] = element;
+        writeIndex.store (nextPos, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side. Returns the oldest element without removing it, or nullptr if empty.
+    const ElementType* peek() const
+    {
+        const size_t readPos = readIndex.load (std::memory_order_relaxed);
+
+        if (buffer.empty() || readPos == writeIndex.load (std::memory_order_acquire))
+            return nullptr;
+
+        return &buffer[readPos];
+    }
+
+    // Consumer side. Removes the oldest element; only valid after peek() returned non-null.
+    void discard()
+    {
+        readIndex.store (advance (readIndex.load (std::memory_order_relaxed)), std::memory_order_release);
+    }
+
+    // Consumer side. Returns false if the FIFO is empty.
+    bool pop (ElementType& element)
+    {
+        const ElementType* oldest = peek();
+
+        if (oldest == nullptr)
+            return false;
+
+        element = *oldest;
+        discard();
+        return true;
+    }
+
+private:
+    size_t advance (size_t index) const
+    {
+        return (index + 1 == buffer.size()) ? 0 : index + 1;
+    }
+
+    std::vector<ElementType> buffer;
+    std::atomic<size_t> readIndex { 0 };
+    std::atomic<size_t> writeIndex { 0 };
+};
+} // namespace TTLDebugTools
+
+#endif
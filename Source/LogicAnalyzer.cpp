@@ -0,0 +1,193 @@
+#include "LogicAnalyzer.h"
+#include "LogicAnalyzerEditor.h"
+
+using namespace TTLDebugTools;
+
+// Constructor.
+TTLLogicAnalyzer::TTLLogicAnalyzer() : TTLPanelBase ("TTL Logic Analyzer", false)
+{
+}
+
+// Destructor.
+TTLLogicAnalyzer::~TTLLogicAnalyzer()
+{
+}
+
+void TTLLogicAnalyzer::registerParameters()
+{
+    TTLPanelBase::registerParameters();
+
+    addStringParameter (Parameter::PROCESSOR_SCOPE,
+                        "groups",
+                        "Groups",
+                        "Lines to decode, e.g. \"1-8; 9-24 s be\". \"be\" swaps the byte order of groups that are whole bytes. Values beyond 24 bits lose precision.",
+                        "1-8",
+                        true);
+}
+
+AudioProcessorEditor* TTLLogicAnalyzer::createEditor()
+{
+    editor = std::make_unique<TTLLogicAnalyzerEditor> (this);
+    return editor.get();
+}
+
+void TTLLogicAnalyzer::parseGroups()
+{
+    groups.clear();
+
+    Parameter* groupsParam = getParameter ("groups");
+
+    if (groupsParam == nullptr)
+        return;
+
+    StringArray groupTexts = StringArray::fromTokens (groupsParam->getValue().toString(), ";", "");
+    groupTexts.trim();
+    groupTexts.removeEmptyStrings();
+
+    for (auto groupText : groupTexts)
+    {
+        StringArray tokens = StringArray::fromTokens (groupText, " ", "");
+        tokens.removeEmptyStrings();
+
+        DecodedGroup decoded;
+        String error;
+
+        if (! decoded.group.parse (tokens[0], error))
+        {
+            LOGE (getName(), ": ", error);
+            CoreServices::sendStatusMessage (getName() + ": " + error);
+            continue;
+        }
+
+        bool bigEndian = false;
+
+        for (int tokenIndex = 1; tokenIndex < tokens.size(); tokenIndex++)
+        {
+            const String flag = tokens[tokenIndex].toLowerCase();
+
+            if (flag == "s")
+                decoded.isSigned = true;
+            else if (flag == "u")
+                decoded.isSigned = false;
+            else if (flag == "be")
+                bigEndian = true;
+            else if (flag == "le")
+                bigEndian = false;
+            else
+                CoreServices::sendStatusMessage (getName() + ": ignoring \"" + tokens[tokenIndex] + "\"");
+        }
+
+        if (bigEndian && ! decoded.group.swapBytes())
+            CoreServices::sendStatusMessage (getName() + ": \"" + tokens[0] + "\" isn't whole bytes, so it can't be big-endian");
+
+        groups.push_back (decoded);
+    }
+}
+
+void TTLLogicAnalyzer::updateSettings()
+{
+    TTLPanelBase::updateSettings();
+
+    parseGroups();
+
+    analyzerStates.clear();
+    analyzerStates.resize (streamStates.size());
+
+    for (auto& state : streamStates)
+    {
+        DataStream* stream = getDataStream (state.streamId);
+
+        for (int groupIndex = 0; groupIndex < int (groups.size()); groupIndex++)
+        {
+            const String letter = String::charToString (char ('A' + groupIndex % 26));
+
+            ContinuousChannel::Settings channelSettings {
+                ContinuousChannel::Type::AUX,
+                "TTL " + letter,
+                "Decoded value of TTL lines in group " + letter,
+                "logicanalyzer.group",
+                1.0f,
+                stream
+            };
+
+            ContinuousChannel* channel = new ContinuousChannel (channelSettings);
+            channel->addProcessor (this);
+            continuousChannels.add (channel);
+
+            analyzerStates[state.slot].channels.push_back (channel);
+        }
+    }
+}
+
+void TTLLogicAnalyzer::parameterValueChanged (Parameter* parameter)
+{
+    if (parameter != nullptr && parameter->getName() == "groups")
+        CoreServices::updateSignalChain (getEditor());
+    else
+        TTLPanelBase::parameterValueChanged (parameter);
+}
+
+float TTLLogicAnalyzer::DecodedGroup::decode (uint64 word) const
+{
+    const uint64 value = group.extract (word);
+    const int numLines = group.getNumLines();
+
+    if (isSigned && numLines > 0 && numLines < 64 && ((value >> (numLines - 1)) & 1))
+        return float (int64 (value) - (int64 (1) << numLines));
+
+    if (isSigned && numLines == 64)
+        return float (int64 (value));
+
+    return float (value);
+}
+
+// One decode and one vectorised fill per group per run of constant input, rather than per sample.
+void TTLLogicAnalyzer::fillTo (const TTLStreamState& state, int endOffset)
+{
+    AnalyzerStreamState& analyzer = analyzerStates[state.slot];
+    const int startOffset = analyzer.filledUpTo;
+
+    endOffset = jmin (endOffset, state.blockSamples);
+
+    if (endOffset <= startOffset)
+        return;
+
+    for (size_t groupIndex = 0; groupIndex < groups.size(); groupIndex++)
+    {
+        float* samples = currentBuffer->getWritePointer (analyzer.channels[groupIndex]->getGlobalIndex());
+        FloatVectorOperations::fill (samples + startOffset, groups[groupIndex].decode (state.currentWord), endOffset - startOffset);
+    }
+
+    analyzer.filledUpTo = endOffset;
+}
+
+void TTLLogicAnalyzer::process (AudioBuffer<float>& buffer)
+{
+    TTLDEBUG_INSTRUMENT (beginInstrumentedBlock();)
+
+    currentBuffer = &buffer;
+
+    beginBlock();
+
+    for (auto& analyzer : analyzerStates)
+        analyzer.filledUpTo = 0;
+
+    checkForEvents();
+
+    for (auto& state : streamStates)
+        fillTo (state, state.blockSamples);
+
+    pushStateToDisplay();
+
+    TTLDEBUG_INSTRUMENT (endInstrumentedBlock();)
+}
+
+void TTLLogicAnalyzer::handleTTLEvent (TTLEventPtr event)
+{
+    if (TTLStreamState* state = getStreamState (event->getStreamId()))
+        fillTo (*state, int (event->getSampleNumber() - state->blockFirstSample));
+
+    TTLPanelBase::handleTTLEvent (event);
+}
+
+// This is the end of the file.
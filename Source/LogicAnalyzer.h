@@ -0,0 +1,78 @@
+#ifndef TTLDEBUGLOGICANALYZER_H_DEFINED
+#define TTLDEBUGLOGICANALYZER_H_DEFINED
+
+#include "BitGroups.h"
+#include "PanelBase.h"
+
+namespace TTLDebugTools
+{
+/**
+
+		Decodes groups of input TTL lines into words, and emits each group as a
+		continuous channel so the decoded values can be recorded.
+
+		Groups are written as "lines [s|u] [le|be]", separated by semicolons,
+		e.g. "1-8; 9-24 s be". Little-endian (the default) puts the first listed
+		line in the least significant bit. Big-endian takes the lines a byte at a
+		time, first byte most significant, and only applies to whole bytes; to
+		reverse the bits themselves, list the lines backwards ("8-1").
+
+	*/
+class TTLLogicAnalyzer : public TTLPanelBase
+{
+public:
+    /** Constructor */
+    TTLLogicAnalyzer();
+
+    /** Destructor */
+    ~TTLLogicAnalyzer();
+
+    /** Register parameters */
+    void registerParameters() override;
+
+    /** Create custom editor */
+    AudioProcessorEditor* createEditor() override;
+
+    /** Parses the groups and creates one continuous channel per group per stream */
+    void updateSettings() override;
+
+    /** Walks the input events, filling each channel with runs of constant value */
+    void process (AudioBuffer<float>& buffer) override;
+
+    /** Fills up to the event, then applies it */
+    void handleTTLEvent (TTLEventPtr event) override;
+
+    /** Rebuilds the signal chain when the group definitions change */
+    void parameterValueChanged (Parameter* parameter) override;
+
+private:
+    struct DecodedGroup
+    {
+        TTLBitGroup group;
+        bool isSigned = false;
+
+        // Decodes a TTL word into this group's value.
+        float decode (uint64 word) const;
+    };
+
+    struct AnalyzerStreamState
+    {
+        std::vector<ContinuousChannel*> channels;
+        int filledUpTo = 0;
+    };
+
+    /** Parses the "groups" parameter into "groups" */
+    void parseGroups();
+
+    /** Writes the stream's current decoded values from "filledUpTo" up to (not including) "endOffset" */
+    void fillTo (const TTLStreamState& state, int endOffset);
+
+    std::vector<DecodedGroup> groups;
+    std::vector<AnalyzerStreamState> analyzerStates;
+    AudioBuffer<float>* currentBuffer = nullptr;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TTLLogicAnalyzer);
+};
+} // namespace TTLDebugTools
+
+#endif
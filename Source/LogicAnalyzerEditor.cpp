@@ -0,0 +1,44 @@
+#include "LogicAnalyzerEditor.h"
+#include "LogicAnalyzer.h"
+
+using namespace TTLDebugTools;
+
+// Constructor.
+TTLLogicAnalyzerEditor::TTLLogicAnalyzerEditor (TTLLogicAnalyzer* newParent) : GenericEditor (newParent)
+{
+    parent = newParent;
+
+    addTextBoxParameterEditor (Parameter::PROCESSOR_SCOPE, "groups", 10, 30);
+
+#if TTLDEBUG_PANEL_INSTRUMENTATION
+    // Writes the hot-path counters to the log, and shows them as a tooltip.
+    perfButton = std::make_unique<UtilityButton> ("Perf");
+    perfButton->addListener (this);
+    perfButton->setRadius (3.0f);
+    perfButton->setBounds (10, 85, 40, 18);
+    addAndMakeVisible (perfButton.get());
+#endif
+
+    setDesiredWidth (160);
+}
+
+// Destructor.
+TTLLogicAnalyzerEditor::~TTLLogicAnalyzerEditor()
+{
+}
+
+// Dumps the instrumentation counters.
+void TTLLogicAnalyzerEditor::buttonClicked (Button* button)
+{
+#if TTLDEBUG_PANEL_INSTRUMENTATION
+    if (button == perfButton.get())
+    {
+        parent->logInstrumentation();
+        perfButton->setTooltip (parent->getInstrumentationSummary());
+    }
+#else
+    ignoreUnused (button);
+#endif
+}
+
+// This is the end of the file.
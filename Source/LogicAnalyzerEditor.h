@@ -0,0 +1,34 @@
+#ifndef TTLDEBUGLOGICANALYZEREDITOR_H_DEFINED
+#define TTLDEBUGLOGICANALYZEREDITOR_H_DEFINED
+
+#include <EditorHeaders.h>
+
+namespace TTLDebugTools
+{
+class TTLLogicAnalyzer;
+
+// Group definitions for the logic analyzer.
+class TTLLogicAnalyzerEditor : public GenericEditor,
+                               public Button::Listener
+{
+public:
+    /** Constructor */
+    TTLLogicAnalyzerEditor (TTLLogicAnalyzer* newParent);
+
+    /** Destructor */
+    ~TTLLogicAnalyzerEditor();
+
+    /** Button callback */
+    void buttonClicked (Button* button);
+
+private:
+    TTLLogicAnalyzer* parent;
+#if TTLDEBUG_PANEL_INSTRUMENTATION
+    std::unique_ptr<UtilityButton> perfButton;
+#endif
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TTLLogicAnalyzerEditor);
+};
+} // namespace TTLDebugTools
+
+#endif
@@ -20,7 +20,10 @@ You should have received a copy of the GNU General Public License
 along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
-#include "PanelBase.h"
+#include "FrontPanel.h"
+#include "LogicAnalyzer.h"
+#include "PatternGenerator.h"
+#include "TogglePanel.h"
 #include <PluginInfo.h>
 #include <string>
 
@@ -33,7 +36,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 using namespace Plugin;
 //Number of plugins defined on the library. Can be of different types (Processors, RecordEngines, etc...)
-#define NUM_PLUGINS 2
+#define NUM_PLUGINS 4
 
 extern "C" EXPORT void getLibInfo (Plugin::LibraryInfo* info)
 {
@@ -71,12 +74,34 @@ extern "C" EXPORT int getPluginInfo (int index, Plugin::PluginInfo* info)
             info->type = Plugin::Type::PROCESSOR;
             //Processor name shown in the GUI.
             info->processor.name = "TTL Display Panel";
-            //Type of processor.
-            info->processor.type = Plugin::Processor::SINK;
+            //Type of processor. A filter, so its barcode events reach downstream processors.
+            info->processor.type = Plugin::Processor::FILTER;
             //Class factory pointer. Namespace and class name.
             info->processor.creator = &(Plugin::createProcessor<TTLDebugTools::TTLFrontPanel>);
             break;
 
+        case 2:
+            // Sources, sinks, and visualizers are all "processors".
+            info->type = Plugin::Type::PROCESSOR;
+            //Processor name shown in the GUI.
+            info->processor.name = "TTL Pattern Generator";
+            //Type of processor.
+            info->processor.type = Plugin::Processor::FILTER;
+            //Class factory pointer. Namespace and class name.
+            info->processor.creator = &(Plugin::createProcessor<TTLDebugTools::TTLPatternGenerator>);
+            break;
+
+        case 3:
+            // Sources, sinks, and visualizers are all "processors".
+            info->type = Plugin::Type::PROCESSOR;
+            //Processor name shown in the GUI.
+            info->processor.name = "TTL Logic Analyzer";
+            //Type of processor.
+            info->processor.type = Plugin::Processor::FILTER;
+            //Class factory pointer. Namespace and class name.
+            info->processor.creator = &(Plugin::createProcessor<TTLDebugTools::TTLLogicAnalyzer>);
+            break;
+
         default:
             return -1;
             break;
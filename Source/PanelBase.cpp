@@ -1,15 +1,46 @@
 #include "PanelBase.h"
 #include "PanelBaseEditor.h"
 #include <climits>
+#include <cmath>
 
 using namespace TTLDebugTools;
 
+// The ttl_word parameter holds the word in hexadecimal with a "0x" prefix, so all 64 lines survive a save.
+// Older settings stored a plain decimal int offset by INT_MAX, so word 0 was -INT_MAX and word INT_MAX was 0.
+// The prefix is what tells the two apart: anything without it is decoded the old way.
+uint64 TTLPanelBase::wordFromParameterValue (const var& value)
+{
+    const String text = value.toString().trim();
+    uint64 word = 0;
+
+    if (text.startsWith ("0x") || text.startsWith ("0X"))
+        return parseTTLWord (text, word) ? word : 0;
+
+    const String digits = text.startsWithChar ('-') ? text.substring (1) : text;
+
+    if (digits.isEmpty() || ! digits.containsOnly ("0123456789"))
+        return 0;
+
+    return uint64 (jlimit (int64 (0), int64 (UINT32_MAX), text.getLargeIntValue() + INT_MAX));
+}
+
+String TTLPanelBase::wordToParameterValue (uint64 word)
+{
+    return "0x" + String::toHexString (int64 (word));
+}
+
 // Base class for front panel and toggle panel.
 
 // Constructor.
 TTLPanelBase::TTLPanelBase (const std::string& name, bool wantSource) : GenericProcessor (name)
 {
     isTTLSource = wantSource;
+
+    outputChannelDescription = "Triggers whenever a TTL button is toggled.";
+    outputChannelIdentifier = "togglepanel.ttl";
+
+    // Allocate once, up front; the queue is never resized while running.
+    commandQueue.resize (TTLDEBUG_PANEL_COMMAND_QUEUE_SIZE);
 }
 
 // Destructor.
@@ -22,14 +53,12 @@ void TTLPanelBase::registerParameters()
 {
     if (isTTLSource)
     {
-        addIntParameter (Parameter::STREAM_SCOPE,
-                         "ttl_word",
-                         "Word",
-                         "TTL word for a given stream",
-                         INT_MIN + 1,
-                         INT_MIN,
-                         INT_MAX,
-                         false);
+        addStringParameter (Parameter::STREAM_SCOPE,
+                            "ttl_word",
+                            "Word",
+                            "TTL word for a given stream",
+                            "0x0",
+                            false);
     }
 }
 
@@ -45,23 +74,27 @@ AudioProcessorEditor* TTLPanelBase::createEditor()
 // This is where we detect input geometry, for the front panel.
 void TTLPanelBase::updateSettings()
 {
-    localEventChannels.clear();
-    currentTTLWord.clear();
-    lastTTLWord.clear();
+    streamStates.clear();
+    streamSlots.clear();
 
     for (auto stream : getDataStreams())
     {
         const uint16 streamId = stream->getStreamId();
 
+        TTLStreamState state;
+        state.slot = int (streamStates.size());
+        state.streamId = streamId;
+        state.sampleRate = stream->getSampleRate();
+
         if (isTTLSource)
         {
             // TTL Channel
             EventChannel* ttlChan;
             EventChannel::Settings ttlChannelSettings {
                 EventChannel::Type::TTL,
-                "TTL Toggle Panel output",
-                "Triggers whenever a TTL button is toggled.",
-                "togglepanel.ttl",
+                getName() + " output",
+                outputChannelDescription,
+                outputChannelIdentifier,
                 getDataStream (stream->getStreamId())
             };
 
@@ -69,127 +102,449 @@ void TTLPanelBase::updateSettings()
             ttlChan->addProcessor (this);
             eventChannels.add (ttlChan);
 
-            localEventChannels[streamId] = eventChannels.getLast();
+            state.eventChannel = eventChannels.getLast();
         }
 
-        currentTTLWord[streamId] = 0;
-        lastTTLWord[streamId] = 0;
+        if (streamId >= streamSlots.size())
+            streamSlots.resize (streamId + 1, -1);
 
-        if (isTTLSource)
+        streamSlots[streamId] = int (streamStates.size());
+        streamStates.push_back (state);
+    }
+
+    displayState.resize (streamStates.size());
+    publishedWords.assign (streamStates.size(), 0);
+    publishedEdges.assign (streamStates.size(), 0);
+    publishedBarcodes.assign (streamStates.size(), 0);
+
+    transitionQueue.resize (keepsTransitionHistory ? TTLDEBUG_PANEL_TRANSITION_QUEUE_SIZE : 0);
+    publishAll = true;
+
+    if (isTTLSource)
+    {
+        for (auto stream : getDataStreams())
             parameterValueChanged (stream->getParameter ("ttl_word"));
     }
 
     pushStateToDisplay();
 }
 
+bool TTLPanelBase::startAcquisition()
+{
+    // A command queued after the last block of the previous run would be applied in the first block of this one,
+    // with a stale timestamp. The audio thread isn't running yet, so it's safe to pop from here.
+    TTLPanelCommand command;
+
+    while (commandQueue.pop (command))
+        LOGD ("Dropping a command left over from the previous run for stream ", command.streamId);
+
+    return true;
+}
+
 bool TTLPanelBase::stopAcquisition()
 {
-    // Reset the last TTL word.
-    for (auto& pair : lastTTLWord)
+    // Reset the last TTL word, and forget pulses that were still running.
+    for (auto& state : streamStates)
     {
-        pair.second = 0;
+        state.lastWord = 0;
+        state.pulses.reset();
     }
 
     return true; // Indicate that acquisition was stopped successfully.
 }
 
+// Stream ID lookup. This is a flat table, so it's safe on the audio thread.
+TTLStreamState* TTLPanelBase::getStreamState (uint16 streamId)
+{
+    if (streamId >= streamSlots.size() || streamSlots[streamId] < 0)
+        return nullptr;
+
+    return &streamStates[streamSlots[streamId]];
+}
+
+void TTLPanelBase::beginBlock()
+{
+    for (auto& state : streamStates)
+    {
+        state.blockFirstSample = getFirstSampleNumberForBlock (state.streamId);
+        state.blockSamples = int (getNumSamplesInBlock (state.streamId));
+        state.nextFreeOffset = 0;
+    }
+}
+
+// The newest sample in the block is taken to have been acquired "now"; a request
+// made N seconds ago lands N * sampleRate samples before the end of the block.
+int TTLPanelBase::getSampleOffsetForTicks (const TTLStreamState& state, int64 requestTicks, int64 nowTicks) const
+{
+    if (state.blockSamples <= 0)
+        return 0;
+
+    const double ageSeconds = Time::highResolutionTicksToSeconds (jmax (int64 (0), nowTicks - requestTicks));
+    const int64 ageSamples = int64 (std::llround (ageSeconds * state.sampleRate));
+    const int64 offset = int64 (state.blockSamples - 1) - ageSamples;
+
+    return int (jlimit (int64 (state.nextFreeOffset), int64 (state.blockSamples - 1), offset));
+}
+
+void TTLPanelBase::emitWord (TTLStreamState& state, int sampleOffset)
+{
+    const uint64 outputWord = state.getOutputWord();
+
+    if (outputWord == state.lastWord)
+        return;
+
+    // One event per changed line, straight into the output buffer; no list of events is built.
+    // Each event is still a fresh allocation; the API can't re-stamp a pooled one (see TODO.md).
+    for (uint64 changed = outputWord ^ state.lastWord; changed != 0; changed &= changed - 1)
+    {
+        const int line = getLowestSetBit (changed);
+
+        addEvent (TTLEvent::createTTLEvent (state.eventChannel,
+                                            state.blockFirstSample + sampleOffset,
+                                            uint8 (line),
+                                            ((outputWord >> line) & 1) != 0),
+                  sampleOffset);
+
+        TTLDEBUG_INSTRUMENT (TTLPanelCounters::add (counters.eventsEmitted, 1); blockEvents++;)
+    }
+
+    state.activity.countEdges (state.lastWord, outputWord);
+    state.lastWord = outputWord;
+
+    recordTransition (state, state.blockFirstSample + sampleOffset);
+    state.nextFreeOffset = sampleOffset;
+}
+
+// Walks pulse ends in time order, so pulses shorter than a block get both edges in the right place.
+void TTLPanelBase::releasePulses (TTLStreamState& state, int64 sampleNumber)
+{
+    int64 endSample = state.pulses.getNextEndSample();
+
+    while (endSample >= 0 && endSample < sampleNumber)
+    {
+        state.pulses.releaseUntil (endSample);
+
+        emitWord (state, getBlockOffset (state, endSample));
+
+        endSample = state.pulses.getNextEndSample();
+    }
+}
+
+int TTLPanelBase::getBlockOffset (const TTLStreamState& state, int64 sampleNumber) const
+{
+    return int (jlimit (int64 (state.nextFreeOffset), int64 (jmax (0, state.blockSamples - 1)), sampleNumber - state.blockFirstSample));
+}
+
+void TTLPanelBase::advanceStream (TTLStreamState& state, int64 sampleNumber)
+{
+    releasePulses (state, sampleNumber);
+}
+
+void TTLPanelBase::applyCommand (TTLStreamState& state, const TTLPanelCommand& command, int64 sampleNumber)
+{
+    if (command.type == TTLPanelCommand::Pulse)
+    {
+        const int64 lengthSamples = jmax (int64 (1), int64 (std::llround (command.lengthMs * 0.001 * state.sampleRate)));
+        state.pulses.start (command.line, command.activeHigh, sampleNumber + lengthSamples);
+    }
+    else if (command.type == TTLPanelCommand::SetWord)
+    {
+        state.currentWord = command.word;
+    }
+
+    emitWord (state, getBlockOffset (state, sampleNumber));
+}
+
+void TTLPanelBase::applyQueuedCommands (int64 nowTicks)
+{
+    TTLPanelCommand command;
+
+    while (commandQueue.pop (command))
+    {
+        if (command.allStreams)
+        {
+            for (auto& state : streamStates)
+                applyQueuedCommand (state, command, nowTicks);
+        }
+        else if (TTLStreamState* state = getStreamState (command.streamId))
+        {
+            applyQueuedCommand (*state, command, nowTicks);
+        }
+    }
+}
+
+void TTLPanelBase::applyQueuedCommand (TTLStreamState& state, const TTLPanelCommand& command, int64 nowTicks)
+{
+    const int64 sampleNumber = state.blockFirstSample + getSampleOffsetForTicks (state, command.requestTicks, nowTicks);
+
+    // Anything scheduled before this command takes effect first (ties go to the schedule).
+    advanceStream (state, sampleNumber + 1);
+    applyCommand (state, command, sampleNumber);
+}
+
+bool TTLPanelBase::queueCommand (const TTLPanelCommand& command)
+{
+    if (commandQueue.push (command))
+        return true;
+
+    LOGE ("TTL panel command queue full; dropping a command for stream ", command.streamId);
+    return false;
+}
+
 // Processing loop.
-void TTLPanelBase::process (AudioSampleBuffer& buffer)
+void TTLPanelBase::process (AudioSampleBuffer&)
 {
+    TTLDEBUG_INSTRUMENT (beginInstrumentedBlock();)
+
     // If we're a filter, report queued changes to TTL output state.
-    // If we're a sink, input events will be received via handleEvent(); we still need to call checkForEvents().
+    // If we're a display, input events will be received via handleEvent(); we still need to call checkForEvents().
 
     if (isTTLSource)
     {
         // We're a filter.
         // Generate state change events on the appropriate stream.
 
-        for (auto stream : dataStreams)
-        {
-            const uint16 streamId = stream->getStreamId();
+        const int64 nowTicks = Time::getHighResolutionTicks();
 
-            if (currentTTLWord[streamId] != lastTTLWord[streamId])
-            {
-                Array<TTLEventPtr> events = TTLEvent::createTTLEvent (localEventChannels[streamId],
-                                                                      getFirstSampleNumberForBlock (streamId),
-                                                                      static_cast<uint64> (currentTTLWord[streamId]));
+        beginBlock();
 
-                for (auto event : events)
-                {
-                    addEvent (event, 0);
-                }
+        // Changes made while stopped (or restored state) go out at the start of the block.
+        for (auto& state : streamStates)
+            emitWord (state, 0);
 
-                lastTTLWord[streamId] = currentTTLWord[streamId];
-            }
-        }
+        // Changes made while running go out at the sample they were requested.
+        applyQueuedCommands (nowTicks);
+
+        // Pulses (and anything else scheduled) that end within this block.
+        for (auto& state : streamStates)
+            advanceStream (state, state.blockFirstSample + state.blockSamples);
     }
     else
     {
-        // We're a sink.
+        // We're a display.
+        beginBlock();
         checkForEvents();
+
+        // Anything a subclass is holding back that's due by the end of the block.
+        for (auto& state : streamStates)
+            advanceStream (state, state.blockFirstSample + state.blockSamples);
     }
+
+    // Lets the strip chart scroll even when nothing changes.
+    if (keepsTransitionHistory && transitionsWanted.load (std::memory_order_relaxed))
+    {
+        for (auto& state : streamStates)
+            recordTransition (state, state.blockFirstSample + state.blockSamples);
+    }
+
+    // Hand the state to the editor once per block, rather than once per event.
+    pushStateToDisplay();
+
+    TTLDEBUG_INSTRUMENT (endInstrumentedBlock();)
+}
+
+#if TTLDEBUG_PANEL_INSTRUMENTATION
+void TTLPanelBase::beginInstrumentedBlock()
+{
+    if (blockDepth++ > 0)
+        return;
+
+    blockStartTicks = Time::getHighResolutionTicks();
+    blockEvents = 0;
 }
 
+void TTLPanelBase::endInstrumentedBlock()
+{
+    if (--blockDepth > 0)
+        return;
+
+    const uint64 blockTicks = uint64 (Time::getHighResolutionTicks() - blockStartTicks);
+
+    TTLPanelCounters::add (counters.blocks, 1);
+    TTLPanelCounters::add (counters.totalTicks, blockTicks);
+    TTLPanelCounters::raise (counters.maxTicks, blockTicks);
+    TTLPanelCounters::raise (counters.peakEventsPerBlock, blockEvents);
+}
+#endif
+
 // Input TTL events enter via this hook.
 void TTLPanelBase::handleTTLEvent (TTLEventPtr event)
 {
-    const uint16 streamId = event->getStreamId();
-    bool ttlState = event->getState();
-    int ttlBit = event->getLine();
+    TTLDEBUG_INSTRUMENT (countReceivedEvent();)
 
-    if (ttlState)
-        currentTTLWord[streamId] |= (1 << ttlBit);
-    else
-        currentTTLWord[streamId] &= ~(1 << ttlBit);
+    TTLStreamState* state = getStreamState (event->getStreamId());
 
-    pushStateToDisplay();
+    if (state == nullptr || event->getLine() >= TTLDEBUG_PANEL_TOTAL_BITS)
+        return;
+
+    applyInputEdge (*state, event->getLine(), event->getState(), event->getSampleNumber());
 }
 
-// Pushes latest state to display
-void TTLPanelBase::pushStateToDisplay()
+void TTLPanelBase::applyInputEdge (TTLStreamState& state, int line, bool level, int64 sampleNumber)
 {
-    TTLPanelBaseEditor* editor = (TTLPanelBaseEditor*) getEditor();
+    if (level)
+        state.currentWord |= (uint64 (1) << line);
+    else
+        state.currentWord &= ~(uint64 (1) << line);
+
+    state.activity.countEdge (line, level);
 
-    editor->pushStateToEditor (currentTTLWord);
+    recordTransition (state, sampleNumber);
 }
 
-void TTLPanelBase::setParameter (int index, float newValue)
+// Publishes latest state to the display.
+// This never blocks or allocates, so it's safe to call from the audio thread.
+void TTLPanelBase::pushStateToDisplay()
 {
-    DataStream* stream = nullptr;
+    bool changed = publishAll;
 
-    if (dataStreams.size() > 0)
+    for (size_t slot = 0; slot < streamStates.size(); slot++)
     {
-        if (editor != nullptr)
-            stream = getDataStream (editor->getCurrentStream());
-        else
-            stream = getDataStream (0); // Default to first stream if no editor.
-    }
-    else
-    {
-        return;
+        const uint64 word = streamStates[slot].getOutputWord();
+        const uint32 edges = streamStates[slot].activity.totalEdges;
+        const uint32 barcodes = streamStates[slot].barcode.count;
+
+        // A pulse that starts and ends within one block leaves the word alone, but not the edge count.
+        changed |= (word != publishedWords[slot] || edges != publishedEdges[slot] || barcodes != publishedBarcodes[slot]);
+        publishedWords[slot] = word;
+        publishedEdges[slot] = edges;
+        publishedBarcodes[slot] = barcodes;
     }
 
-    if (auto* ttlWordParam = stream->getParameter ("ttl_word"))
+    if (changed)
     {
-        ttlWordParam->updateValue();
-        parameterValueChanged (ttlWordParam);
-        CoreServices::sendStatusMessage ("Set " + getName() + " " + ttlWordParam->getDisplayName() + ": " + String (currentTTLWord[stream->getStreamId()]));
+        TTLDisplayState* states = displayState.getWriteBuffer();
+
+        for (size_t slot = 0; slot < streamStates.size(); slot++)
+        {
+            states[slot].word = publishedWords[slot];
+            states[slot].activity = streamStates[slot].activity;
+            states[slot].barcode = streamStates[slot].barcode;
+        }
+
+        // A snapshot the editor never picked up counts as a dropped update.
+        const bool dropped = displayState.publish();
+        TTLDEBUG_INSTRUMENT (if (dropped) TTLPanelCounters::add (counters.droppedDisplayUpdates, 1);)
+        ignoreUnused (dropped);
+
+        publishAll = false;
     }
 }
 
+void TTLPanelBase::recordTransition (const TTLStreamState& state, int64 sampleNumber)
+{
+    if (! keepsTransitionHistory || ! transitionsWanted.load (std::memory_order_relaxed))
+        return;
+
+    TTLTransition transition;
+    transition.sampleNumber = sampleNumber;
+    transition.word = state.getOutputWord();
+    transition.slot = state.slot;
+
+    if (! transitionQueue.push (transition))
+        droppedTransitions.fetch_add (1, std::memory_order_relaxed);
+}
+
+#if TTLDEBUG_PANEL_INSTRUMENTATION
+String TTLPanelBase::getInstrumentationSummary() const
+{
+    const uint64 blocks = counters.blocks.load (std::memory_order_relaxed);
+    const double ticksPerMicrosecond = double (Time::getHighResolutionTicksPerSecond()) * 1.0e-6;
+    const double meanMicroseconds = blocks > 0 ? double (counters.totalTicks.load (std::memory_order_relaxed)) / blocks / ticksPerMicrosecond : 0.0;
+    const double maxMicroseconds = double (counters.maxTicks.load (std::memory_order_relaxed)) / ticksPerMicrosecond;
+
+    return String (blocks) + " blocks, " + String (meanMicroseconds, 2) + " us mean, " + String (maxMicroseconds, 2) + " us max; "
+           + String (counters.eventsReceived.load (std::memory_order_relaxed)) + " events in, "
+           + String (counters.eventsEmitted.load (std::memory_order_relaxed)) + " out, "
+           + String (counters.peakEventsPerBlock.load (std::memory_order_relaxed)) + " peak per block; "
+           + String (counters.droppedDisplayUpdates.load (std::memory_order_relaxed)) + " display updates dropped";
+}
+
+void TTLPanelBase::logInstrumentation() const
+{
+    LOGC (getName(), ": ", getInstrumentationSummary());
+}
+#endif
+
+void TTLPanelBase::setTransitionsWanted (bool shouldRecord)
+{
+    if (shouldRecord)
+        droppedTransitions.store (0, std::memory_order_relaxed);
+
+    transitionsWanted.store (shouldRecord, std::memory_order_relaxed);
+}
+
+bool TTLPanelBase::popTransition (TTLTransition& transition)
+{
+    return transitionQueue.pop (transition);
+}
+
+uint32 TTLPanelBase::getNumDroppedTransitions() const
+{
+    return droppedTransitions.load (std::memory_order_relaxed);
+}
+
+// Picks up the latest published state. Called from the editor's refresh timer.
+bool TTLPanelBase::pullStateFromProcessor (std::map<uint16, TTLDisplayState>& states)
+{
+    if (! displayState.pull())
+        return false;
+
+    const TTLDisplayState* published = displayState.getReadBuffer();
+
+    for (size_t slot = 0; slot < streamStates.size(); slot++)
+        states[streamStates[slot].streamId] = published[slot];
+
+    return true;
+}
+
+void TTLPanelBase::setParameter (int index, float newValue)
+{
+    // Stamp the request as early as possible; process() maps this to a sample.
+    pendingRequestTicks = Time::getHighResolutionTicks();
+
+    // The base class updates whichever parameter changed and calls parameterValueChanged() for it.
+    GenericProcessor::setParameter (index, newValue);
+}
+
 // Parameter accessor. This is guaranteed to be called under safe conditions.
 // Variables used by "process" should only be modified here.
 void TTLPanelBase::parameterValueChanged (Parameter* parameter)
 {
     LOGD ("Parameter value changed for ", parameter->getName());
-    const uint16 streamId = parameter->getStreamId();
 
-    int64 valueI64 = int64 (parameter->getValue());
-    uint32 valueU32 = uint32 (valueI64 + INT_MAX);
+    // Everything else is only read by the editor.
+    if (parameter->getName() != "ttl_word")
+        return;
 
-    currentTTLWord[streamId] = valueU32;
+    TTLStreamState* state = getStreamState (parameter->getStreamId());
 
-    pushStateToDisplay();
+    if (state == nullptr)
+        return;
+
+    const uint64 word = wordFromParameterValue (parameter->getValue());
+
+    if (CoreServices::getAcquisitionStatus())
+    {
+        if (broadcastingWord)
+            return;
+
+        // While running, process() owns the stream state; hand the change over with its timestamp.
+        TTLPanelCommand command;
+        command.requestTicks = pendingRequestTicks;
+        command.streamId = state->streamId;
+        command.word = word;
+
+        if (queueCommand (command))
+            CoreServices::sendStatusMessage ("Set " + getName() + " " + parameter->getDisplayName() + ": " + String (word));
+
+        // process() publishes the state at the end of the next block.
+    }
+    else
+    {
+        state->currentWord = word;
+        pushStateToDisplay();
+    }
 }
 
 bool TTLPanelBase::isEventSourcePanel()
@@ -199,24 +554,107 @@ bool TTLPanelBase::isEventSourcePanel()
     return isTTLSource;
 }
 
-// Toggle panel (filter).
+// Pulses go through the command queue, so they start at the sample they were requested.
+void TTLPanelBase::triggerPulse (uint16 streamId, int line, bool activeHigh, float lengthMs)
+{
+    if (line < 0 || line >= TTLDEBUG_PANEL_TOTAL_BITS)
+    {
+        LOGE (getName(), ": can't pulse line ", line + 1, "; there are only ", TTLDEBUG_PANEL_TOTAL_BITS);
+        return;
+    }
 
-TTLTogglePanel::TTLTogglePanel() : TTLPanelBase ("TTL Toggle Panel", true)
+    // Pulses are timed against the running stream, so there's nothing to time them against while stopped.
+    if (! CoreServices::getAcquisitionStatus())
+    {
+        CoreServices::sendStatusMessage (getName() + ": pulses only work while acquiring");
+        return;
+    }
+
+    TTLPanelCommand command;
+    command.type = TTLPanelCommand::Pulse;
+    command.requestTicks = Time::getHighResolutionTicks();
+    command.streamId = streamId;
+    command.line = line;
+    command.activeHigh = activeHigh;
+    command.lengthMs = lengthMs;
+
+    queueCommand (command);
+}
+
+// A single command for every stream, so N streams can't straddle a block boundary the way N parameter changes can.
+void TTLPanelBase::setWordOnAllStreams (uint64 word)
 {
+    if (CoreServices::getAcquisitionStatus())
+    {
+        TTLPanelCommand command;
+        command.requestTicks = Time::getHighResolutionTicks();
+        command.allStreams = true;
+        command.word = word;
+
+        if (queueCommand (command))
+            CoreServices::sendStatusMessage ("Set " + getName() + " word on all streams: " + String (word));
+    }
+
+    // Keep the parameters in step, so the words survive a stop and a save.
+    broadcastingWord = true;
+
+    for (auto stream : getDataStreams())
+    {
+        if (Parameter* ttlWordParam = stream->getParameter ("ttl_word"))
+            ttlWordParam->setNextValue (var (wordToParameterValue (word)), false);
+    }
+
+    broadcastingWord = false;
 }
 
-TTLTogglePanel::~TTLTogglePanel()
+// Pulse scheduler.
+
+void TTLPulseScheduler::reset()
 {
+    activeMask = 0;
+    activeLevels = 0;
 }
 
-// Front panel (sink).
+void TTLPulseScheduler::start (int line, bool activeHigh, int64 endSample)
+{
+    const uint64 bit = uint64 (1) << line;
+
+    activeMask |= bit;
 
-TTLFrontPanel::TTLFrontPanel() : TTLPanelBase ("TTL Display Panel", false)
+    if (activeHigh)
+        activeLevels |= bit;
+    else
+        activeLevels &= ~bit;
+
+    endSamples[line] = endSample;
+}
+
+int64 TTLPulseScheduler::getNextEndSample() const
 {
+    int64 earliest = -1;
+
+    for (uint64 pending = activeMask; pending != 0; pending &= pending - 1)
+    {
+        const int line = getLowestSetBit (pending);
+
+        if (earliest < 0 || endSamples[line] < earliest)
+            earliest = endSamples[line];
+    }
+
+    return earliest;
 }
 
-TTLFrontPanel::~TTLFrontPanel()
+void TTLPulseScheduler::releaseUntil (int64 sampleNumber)
 {
+    for (uint64 pending = activeMask; pending != 0; pending &= pending - 1)
+    {
+        const int line = getLowestSetBit (pending);
+
+        if (endSamples[line] <= sampleNumber)
+            activeMask &= ~(uint64 (1) << line);
+    }
+
+    activeLevels &= activeMask;
 }
 
 // This is the end of the file.
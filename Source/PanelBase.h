@@ -3,11 +3,37 @@
 
 #include <ProcessorHeaders.h>
 
+#include "LockFreeFifo.h"
+#include "SnapshotBuffer.h"
+#include "BitGroups.h"
+#include "Barcode.h"
+#include <cstdint>
+
+// Set to 1 to build hot-path instrumentation into the panels. With 0, the hooks compile to nothing.
+#ifndef TTLDEBUG_PANEL_INSTRUMENTATION
+#define TTLDEBUG_PANEL_INSTRUMENTATION 0
+#endif
+
+#if TTLDEBUG_PANEL_INSTRUMENTATION
+#define TTLDEBUG_INSTRUMENT(statement) statement
+#else
+#define TTLDEBUG_INSTRUMENT(statement)
+#endif
+
 // Magic constants for data geometry.
 #define TTLDEBUG_PANEL_BANK_BITS 8
-#define TTLDEBUG_PANEL_MAX_BANKS 4
+#define TTLDEBUG_PANEL_MAX_BANKS 8
 #define TTLDEBUG_PANEL_TOTAL_BITS (TTLDEBUG_PANEL_BANK_BITS * TTLDEBUG_PANEL_MAX_BANKS)
 
+// Maximum number of word changes that can be queued between two blocks.
+#define TTLDEBUG_PANEL_COMMAND_QUEUE_SIZE 256
+
+// Transitions that can be waiting for the strip chart to pick them up.
+#define TTLDEBUG_PANEL_TRANSITION_QUEUE_SIZE 65536
+
+// How often the editor checks for published state.
+#define TTLDEBUG_PANEL_DISPLAY_REFRESH_MS 50
+
 // Magic constants for parameter indices.
 #define TTLDEBUG_PANEL_PARAM_BASE_ENABLED 0
 #define TTLDEBUG_PANEL_PARAM_BASE_OUTPUT TTLDEBUG_PANEL_MAX_BANKS
@@ -15,11 +41,177 @@
 
 namespace TTLDebugTools
 {
+// Index of the lowest set bit of a non-zero word.
+inline int getLowestSetBit (uint64 word)
+{
+    return countNumberOfBits ((word & (~word + 1)) - 1);
+}
+
+// Per-line pulse timers for one stream.
+// Each line holds at most one pending pulse, so storage is fixed and nothing is allocated while running.
+class TTLPulseScheduler
+{
+public:
+    // Cancels all pending pulses.
+    void reset();
+
+    // Drives "line" to the active level from now until "endSample". Restarting a running pulse extends it.
+    void start (int line, bool activeHigh, int64 endSample);
+
+    // Returns the sample at which the earliest pending pulse ends, or -1 if none are pending.
+    int64 getNextEndSample() const;
+
+    // Releases every pulse that ends at or before "sampleNumber".
+    void releaseUntil (int64 sampleNumber);
+
+    // Overlays the pulsing lines on a resting word.
+    uint64 apply (uint64 restingWord) const
+    {
+        return (restingWord & ~activeMask) | (activeLevels & activeMask);
+    }
+
+private:
+    uint64 activeMask = 0;
+    uint64 activeLevels = 0;
+    int64 endSamples[TTLDEBUG_PANEL_TOTAL_BITS] = {};
+};
+
+// Edges seen on each line since the stream was set up.
+// The counts only ever grow, so the display can diff any two snapshots even if it missed the ones in between.
+struct TTLLineActivity
+{
+    uint32 risingEdges[TTLDEBUG_PANEL_TOTAL_BITS] = {};
+    uint32 fallingEdges[TTLDEBUG_PANEL_TOTAL_BITS] = {};
+    uint32 totalEdges = 0;
+
+    void countEdge (int line, bool rising)
+    {
+        (rising ? risingEdges : fallingEdges)[line]++;
+        totalEdges++;
+    }
+
+    void countEdges (uint64 previousWord, uint64 newWord)
+    {
+        for (uint64 changed = previousWord ^ newWord; changed != 0; changed &= changed - 1)
+        {
+            const int line = getLowestSetBit (changed);
+            countEdge (line, ((newWord >> line) & 1) != 0);
+        }
+    }
+};
+
+// What the editor gets to see of one stream.
+struct TTLDisplayState
+{
+    uint64 word = 0;
+    TTLLineActivity activity;
+    TTLBarcodeReading barcode;
+};
+
+// One entry in the strip chart feed: from "sampleNumber" on, the stream in "slot" carries "word".
+struct TTLTransition
+{
+    int64 sampleNumber = 0;
+    uint64 word = 0;
+    int slot = 0;
+};
+
+#if TTLDEBUG_PANEL_INSTRUMENTATION
+// Hot-path counters. Written only by the audio thread, so plain loads and stores are enough; any thread may read them.
+struct TTLPanelCounters
+{
+    std::atomic<uint64> blocks { 0 };
+    std::atomic<uint64> totalTicks { 0 };
+    std::atomic<uint64> maxTicks { 0 };
+    std::atomic<uint64> eventsEmitted { 0 };
+    std::atomic<uint64> eventsReceived { 0 };
+    std::atomic<uint64> peakEventsPerBlock { 0 };
+    std::atomic<uint64> droppedDisplayUpdates { 0 };
+
+    static void add (std::atomic<uint64>& counter, uint64 amount)
+    {
+        counter.store (counter.load (std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+
+    static void raise (std::atomic<uint64>& counter, uint64 value)
+    {
+        if (value > counter.load (std::memory_order_relaxed))
+            counter.store (value, std::memory_order_relaxed);
+    }
+};
+#endif
+
+// Per-stream state. Built once in updateSettings() and indexed by slot on the hot path.
+struct TTLStreamState
+{
+    int slot = 0;
+    uint16 streamId = 0;
+    uint64 currentWord = 0;
+    uint64 lastWord = 0;
+    EventChannel* eventChannel = nullptr;
+    float sampleRate = 0.0f;
+
+    // Geometry of the block being processed, cached at the top of process().
+    int64 blockFirstSample = 0;
+    int blockSamples = 0;
+
+    // Events within a block must not go backwards; this is the earliest offset still available.
+    int nextFreeOffset = 0;
+
+    // Lines driven by a generator (e.g. a pattern) rather than the resting word.
+    uint64 overlayMask = 0;
+    uint64 overlayBits = 0;
+
+    // Pulses in progress. The output word is "currentWord" with the overlay and these on top.
+    TTLPulseScheduler pulses;
+
+    // Every edge received (display panels) or emitted (sources), so short pulses still show up.
+    TTLLineActivity activity;
+
+    // Latest barcode decoded from the input (display panels).
+    TTLBarcodeReading barcode;
+
+    uint64 getOutputWord() const
+    {
+        return pulses.apply ((currentWord & ~overlayMask) | (overlayBits & overlayMask));
+    }
+};
+
+// A change requested from the message thread, stamped with the time it was requested.
+struct TTLPanelCommand
+{
+    enum Type
+    {
+        SetWord,
+        Pulse,
+
+        // Manual trigger controls, for subclasses that generate sequences.
+        Trigger,
+        Hold,
+        Release
+    };
+
+    Type type = SetWord;
+    int64 requestTicks = 0;
+    uint16 streamId = 0;
+
+    // Applies to every stream instead of just "streamId", all within the same block.
+    bool allStreams = false;
+
+    // SetWord
+    uint64 word = 0;
+
+    // Pulse
+    int line = 0;
+    bool activeHigh = true;
+    float lengthMs = 0.0f;
+};
+
 class TTLPanelBase : public GenericProcessor
 {
 public:
     /** Constructor.
-			Set "wantSource" true to make this a toggle panel (filter), or false for a front panel (sink) */
+			Set "wantSource" true to make this a toggle panel, with a TTL output, or false for a front panel, which only reads its input */
     TTLPanelBase (const std::string& name, bool wantSource);
 
     /** Destructor */
@@ -34,6 +226,9 @@ public:
     /** Create event channels */
     void updateSettings() override;
 
+    /** Drops commands left over from the previous run */
+    bool startAcquisition() override;
+
     /** Resets last TTL word */
     bool stopAcquisition() override;
 
@@ -55,51 +250,163 @@ public:
     // NOTE - Calling query accessors while running isn't safe!
     bool isEventSourcePanel();
 
-    // Updates the display with latest state.
+    // Message thread. Pulses one output line of a stream, starting at the sample this is called at.
+    // Only while acquiring; otherwise it posts a status message and does nothing.
+    void triggerPulse (uint16 streamId, int line, bool activeHigh, float lengthMs);
+
+    // Message thread. Sets the same word on every stream. While running, every stream changes in the same
+    // block, at the sample matching the moment this is called.
+    void setWordOnAllStreams (uint64 word);
+
+#if TTLDEBUG_PANEL_INSTRUMENTATION
+    // One-line summary of the hot-path counters.
+    String getInstrumentationSummary() const;
+
+    // Writes the summary to the log.
+    void logInstrumentation() const;
+#endif
+
+    // Message thread. Extra detail about one line, for the editor's tooltips; empty if there's nothing to add.
+    virtual String describeLine (uint16, int)
+    {
+        return String();
+    }
+
+    // Decodes the ttl_word parameter. Accepts current and legacy formats.
+    static uint64 wordFromParameterValue (const var& value);
+
+    // Encodes a word for the ttl_word parameter, in the current format.
+    static String wordToParameterValue (uint64 word);
+
+    // Publishes the latest state for the editor to pick up, if it changed. The editor polls for it from a timer,
+    // so nothing here touches the message queue.
+    // Only one thread may publish at a time: the audio thread while running, the message thread otherwise.
     void pushStateToDisplay();
 
+    // Message thread. Starts or stops feeding the strip chart. Nothing is recorded while no chart is animating,
+    // so the queue can't fill up with transitions nobody will read. Starting also clears the drop count.
+    void setTransitionsWanted (bool shouldRecord);
+
+    // Message thread. Pops the oldest transition recorded for the strip chart; returns false if there are none.
+    bool popTransition (TTLTransition& transition);
+
+    // Number of transitions dropped because the strip chart fell behind, since it last started.
+    uint32 getNumDroppedTransitions() const;
+
+    // Returns the per-stream records, in slot order. Message thread, and only while settings aren't changing.
+    const std::vector<TTLStreamState>& getStreamStates() const
+    {
+        return streamStates;
+    }
+
+    // Message thread only. Copies the most recently published state into "states".
+    // Returns false, after a single atomic load, if nothing new was published since the last call.
+    bool pullStateFromProcessor (std::map<uint16, TTLDisplayState>& states);
+
 protected:
+    // Returns the state record for a stream, or nullptr if the stream isn't ours.
+    // O(1), and never inserts; safe to call from the audio thread.
+    TTLStreamState* getStreamState (uint16 streamId);
+
+    // Caches block geometry for every stream. Call once at the top of process().
+    void beginBlock();
+
+    // Maps a high-resolution timestamp to a sample offset within the current block.
+    // Requests older than the block land on its first sample.
+    int getSampleOffsetForTicks (const TTLStreamState& state, int64 requestTicks, int64 nowTicks) const;
+
+    // Emits the events that take a stream's output from "lastWord" to its output word at the given block offset.
+    void emitWord (TTLStreamState& state, int sampleOffset);
+
+    // Ends pulses that finish before "sampleNumber" (absolute), emitting each edge at its own sample.
+    void releasePulses (TTLStreamState& state, int64 sampleNumber);
+
+    // Emits everything scheduled on a stream before "sampleNumber" (absolute), in time order.
+    // Subclasses that generate their own edges override this, and call the base version for pulses.
+    virtual void advanceStream (TTLStreamState& state, int64 sampleNumber);
+
+    // Applies one queued command at the given sample (absolute). Subclasses handle their own command types.
+    virtual void applyCommand (TTLStreamState& state, const TTLPanelCommand& command, int64 sampleNumber);
+
+    // Takes one input edge into the stream's word. Subclasses that filter or analyse inputs override this.
+    virtual void applyInputEdge (TTLStreamState& state, int line, bool level, int64 sampleNumber);
+
+    // Applies queued commands at the sample offsets they were requested at.
+    void applyQueuedCommands (int64 nowTicks);
+
+    // Applies one queued command to one stream, after anything scheduled before it.
+    void applyQueuedCommand (TTLStreamState& state, const TTLPanelCommand& command, int64 nowTicks);
+
+    // Pushes a command for process() to pick up. Message thread only.
+    bool queueCommand (const TTLPanelCommand& command);
+
+    // Returns the block offset of an absolute sample number, clamped so events never go backwards.
+    int getBlockOffset (const TTLStreamState& state, int64 sampleNumber) const;
+
+    // Feeds a stream's output word, from "sampleNumber" on, to the strip chart. Audio thread.
+    void recordTransition (const TTLStreamState& state, int64 sampleNumber);
+
+#if TTLDEBUG_PANEL_INSTRUMENTATION
+    // Brackets one block's work for the timing counters. TTLPanelBase::process() calls these itself; a subclass
+    // that handles events before it, or replaces it, calls them around its own process(). Nested pairs count once.
+    void beginInstrumentedBlock();
+    void endInstrumentedBlock();
+
+    // Counts one input event, for handleTTLEvent() overrides that don't call the base version.
+    void countReceivedEvent()
+    {
+        TTLPanelCounters::add (counters.eventsReceived, 1);
+        blockEvents++;
+    }
+#endif
+
+    // Set by panels with a strip chart, before updateSettings() is first called.
+    bool keepsTransitionHistory = false;
+
     bool isTTLSource;
-    std::map<uint16, uint32> currentTTLWord;
-    std::map<uint16, uint32> lastTTLWord;
-    std::map<uint16, EventChannel*> localEventChannels;
 
-private:
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TTLPanelBase);
-};
+    // Describes the output event channel created for each stream, when we're a source.
+    String outputChannelDescription;
+    String outputChannelIdentifier;
 
-/** 
-		Creates an array of buttons to toggle TTL events on and off
-	*/
-class TTLTogglePanel : public TTLPanelBase
-{
-public:
-    /** Constructor */
-    TTLTogglePanel();
+    // Contiguous per-stream records, in "dataStreams" order. Only resized in updateSettings().
+    std::vector<TTLStreamState> streamStates;
 
-    /** Destructor */
-    ~TTLTogglePanel();
+    // Stream ID to index into "streamStates", or -1.
+    std::vector<int> streamSlots;
 
-private:
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TTLTogglePanel);
-};
+    // One record per stream slot.
+    TripleBuffer<TTLDisplayState> displayState;
 
-/** 
-	
-		Creates an array of indicators to show the state of individual TTL lines
-		
-	*/
-class TTLFrontPanel : public TTLPanelBase
-{
-public:
-    /** Constructor */
-    TTLFrontPanel();
+    // Changes made while running, from the message thread to process().
+    LockFreeFifo<TTLPanelCommand> commandQueue;
 
-    /** Destructor*/
-    ~TTLFrontPanel();
+    // Time at which the parameter change currently being handled was requested.
+    int64 pendingRequestTicks = 0;
+
+    // Set while setWordOnAllStreams() updates the stream parameters, which it has already queued as one command.
+    bool broadcastingWord = false;
 
 private:
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TTLFrontPanel);
+    // Publisher's copy of what was last published, so unchanged state is never published.
+    std::vector<uint64> publishedWords;
+    std::vector<uint32> publishedEdges;
+    std::vector<uint32> publishedBarcodes;
+    bool publishAll = true;
+
+    // Audio thread to strip chart.
+    LockFreeFifo<TTLTransition> transitionQueue;
+    std::atomic<uint32> droppedTransitions { 0 };
+    std::atomic<bool> transitionsWanted { false };
+
+#if TTLDEBUG_PANEL_INSTRUMENTATION
+    TTLPanelCounters counters;
+    uint64 blockEvents = 0;
+    int64 blockStartTicks = 0;
+    int blockDepth = 0;
+#endif
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TTLPanelBase);
 };
 } // namespace TTLDebugTools
 
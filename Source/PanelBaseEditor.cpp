@@ -1,20 +1,19 @@
 #include "PanelBaseEditor.h"
+#include "BitGroups.h"
 #include "PanelBase.h"
-#include <climits>
-#include <sstream>
+#include "StripChartCanvas.h"
 
 using namespace TTLDebugTools;
 
 // Private magic constants for GUI geometry.
 
 #define TITLEBAR_YOFFSET 35
-#define MAX_BUTTONS 32
 
 #define BUTTONROW_YSIZE 14
 #define BUTTONROW_YHALO 4
 #define BUTTONROW_YPITCH (BUTTONROW_YSIZE + BUTTONROW_YHALO + BUTTONROW_YHALO)
 
-#define BITBUTTON_XSIZE 22
+#define BITBUTTON_XSIZE 15
 #define BITBUTTON_XHALO 1
 #define BITBUTTON_XPITCH (BITBUTTON_XSIZE + BITBUTTON_XHALO + BITBUTTON_XHALO)
 #define BITBUTTON_SLAB_XSIZE (BITBUTTON_XPITCH * TTLDEBUG_PANEL_BANK_BITS)
@@ -33,94 +32,535 @@ using namespace TTLDebugTools;
 #define BUTTONROW_XPITCH_EN_NO (BUTTONROW_XSIZE_EN_NO + 2 * BUTTONROW_XHALO)
 #define BUTTONROW_XPITCH_EN_YES (BUTTONROW_XSIZE_EN_YES + 2 * BUTTONROW_XHALO)
 
+#define WORDBOX_XOFFSET (BUTTONROW_XHALO + TTLDEBUG_PANEL_UI_BUTTONS_PER_ROW * BITBUTTON_XPITCH + BUTTONROW_XHALO)
+#define WORDBOX_XSIZE 150
+#define CONTROLS_XOFFSET (WORDBOX_XOFFSET + WORDBOX_XSIZE + BUTTONROW_XHALO)
+
+#define BITGRID_XSIZE (TTLDEBUG_PANEL_UI_BUTTONS_PER_ROW * BITBUTTON_XPITCH)
+#define BITGRID_YSIZE (((TTLDEBUG_PANEL_UI_MAX_BUTTONS + TTLDEBUG_PANEL_UI_BUTTONS_PER_ROW - 1) / TTLDEBUG_PANEL_UI_BUTTONS_PER_ROW) * BUTTONROW_YPITCH)
+
+Colour TTLDebugTools::getTTLLineColour (int line)
+{
+    static const Colour eventColours[] = {
+        Colour (224, 185, 36),
+        Colour (243, 119, 33),
+        Colour (237, 37, 36),
+        Colour (217, 46, 171),
+        Colour (101, 31, 255),
+        Colour (48, 117, 255),
+        Colour (116, 227, 156),
+        Colour (82, 173, 0)
+    };
+
+    return eventColours[line % TTLDEBUG_PANEL_BANK_BITS];
+}
+
 //
-// One bank of TTLs with associated controls.
+// Grid of TTL indicators.
 
 // Constructor.
-TTLPanelButton::TTLPanelButton (int line_, Colour colour_) : Button (String (line)), line (line_), colour (colour_)
+TTLBitGrid::TTLBitGrid()
 {
+    setOpaque (false);
 }
 
 // Destructor.
-TTLPanelButton::~TTLPanelButton()
+TTLBitGrid::~TTLBitGrid()
 {
     // Nothing to do.
 }
 
-// GUI callbacks.
+Rectangle<int> TTLBitGrid::getCellBounds (int line) const
+{
+    const int row = line / TTLDEBUG_PANEL_UI_BUTTONS_PER_ROW;
+    const int column = line % TTLDEBUG_PANEL_UI_BUTTONS_PER_ROW;
+
+    return Rectangle<int> (column * BITBUTTON_XPITCH, row * BUTTONROW_YPITCH, BITBUTTON_XSIZE, BUTTONROW_YSIZE);
+}
 
-void TTLPanelButton::paintButton (Graphics& g, bool isHighlighted, bool isDown)
+// Hit-testing is arithmetic on the grid pitch; the halo between cells isn't part of any cell.
+int TTLBitGrid::getLineAt (Point<int> position) const
 {
-    if (getToggleState())
-        g.setColour (colour);
-    else
-        g.setColour (findColour (ThemeColours::widgetBackground));
+    if (position.x < 0 || position.y < 0)
+        return -1;
 
-    g.fillRect (0, 0, getWidth(), getHeight());
+    if (position.x % BITBUTTON_XPITCH >= BITBUTTON_XSIZE || position.y % BUTTONROW_YPITCH >= BUTTONROW_YSIZE)
+        return -1;
 
-    g.setColour (findColour (ThemeColours::defaultText));
-    g.setFont (11.0f);
-    g.drawText (String (line + 1), Rectangle<float> (getWidth(), getHeight()), Justification::centred);
+    const int column = position.x / BITBUTTON_XPITCH;
+    const int line = (position.y / BUTTONROW_YPITCH) * TTLDEBUG_PANEL_UI_BUTTONS_PER_ROW + column;
+
+    if (column >= TTLDEBUG_PANEL_UI_BUTTONS_PER_ROW || line >= TTLDEBUG_PANEL_UI_MAX_BUTTONS)
+        return -1;
+
+    return line;
+}
+
+void TTLBitGrid::setWord (uint64 newWord)
+{
+    uint64 changed = newWord ^ word;
+    word = newWord;
+
+    for (; changed != 0; changed &= changed - 1)
+    {
+        const int line = getLowestSetBit (changed);
+
+        if (line >= TTLDEBUG_PANEL_UI_MAX_BUTTONS)
+            break;
+
+        repaint (getCellBounds (line));
+    }
+}
+
+void TTLBitGrid::setLatched (uint64 mask)
+{
+    uint64 changed = mask ^ latched;
+    latched = mask;
+
+    for (; changed != 0; changed &= changed - 1)
+    {
+        const int line = getLowestSetBit (changed);
+
+        if (line >= TTLDEBUG_PANEL_UI_MAX_BUTTONS)
+            break;
+
+        repaint (getCellBounds (line));
+    }
+}
+
+void TTLBitGrid::setActivity (const TTLLineActivity& newActivity)
+{
+    activity = newActivity;
+}
+
+String TTLBitGrid::getTooltip()
+{
+    const int line = getLineAt (getMouseXYRelative());
+
+    if (line < 0)
+        return String();
+
+    String tooltip = "Line " + String (line + 1) + ": " + String (activity.risingEdges[line]) + " rising, "
+                     + String (activity.fallingEdges[line]) + " falling";
+
+    if (describeLine)
+    {
+        const String details = describeLine (line);
+
+        if (details.isNotEmpty())
+            tooltip += "\n" + details;
+    }
+
+    return tooltip;
+}
+
+void TTLBitGrid::setClickable (bool shouldBeClickable)
+{
+    clickable = shouldBeClickable;
+    setHoveredLine (-1);
+}
+
+void TTLBitGrid::renderImages()
+{
+    if (getWidth() <= 0 || getHeight() <= 0)
+        return;
+
+    offImage = Image (Image::ARGB, getWidth(), getHeight(), true);
+    onImage = Image (Image::ARGB, getWidth(), getHeight(), true);
+
+    Graphics offGraphics (offImage);
+    Graphics onGraphics (onImage);
+
+    for (int line = 0; line < TTLDEBUG_PANEL_UI_MAX_BUTTONS; line++)
+    {
+        const Rectangle<int> cell = getCellBounds (line);
+        const Colour colour = getTTLLineColour (line);
+
+        offGraphics.setColour (findColour (ThemeColours::widgetBackground));
+        offGraphics.fillRect (cell);
+        onGraphics.setColour (colour);
+        onGraphics.fillRect (cell);
+
+        for (auto* g : { &offGraphics, &onGraphics })
+        {
+            g->setColour (findColour (ThemeColours::defaultText));
+            g->setFont (10.0f);
+            g->drawText (String (line + 1), cell.toFloat(), Justification::centred);
+            g->drawLine (float (cell.getX()), float (cell.getBottom()), float (cell.getRight()), float (cell.getBottom()), 2.0f);
+        }
+    }
+}
+
+// Draws the "off" grid, then copies the "on" cells over it. JUCE clips to the dirty region for us.
+void TTLBitGrid::paint (Graphics& g)
+{
+    if (! offImage.isValid())
+        return;
+
+    g.drawImageAt (offImage, 0, 0);
+
+    const Rectangle<int> clip = g.getClipBounds();
+
+    for (uint64 pending = word; pending != 0; pending &= pending - 1)
+    {
+        const int line = getLowestSetBit (pending);
+
+        if (line >= TTLDEBUG_PANEL_UI_MAX_BUTTONS)
+            break;
+
+        const Rectangle<int> cell = getCellBounds (line);
+
+        if (cell.intersects (clip))
+            g.drawImage (onImage, cell.getX(), cell.getY(), cell.getWidth(), cell.getHeight(), cell.getX(), cell.getY(), cell.getWidth(), cell.getHeight());
+    }
+
+    // A bar along the top of the cell, contrasting with its current state.
+    for (uint64 pending = latched; pending != 0; pending &= pending - 1)
+    {
+        const int line = getLowestSetBit (pending);
+
+        if (line >= TTLDEBUG_PANEL_UI_MAX_BUTTONS)
+            break;
+
+        const Rectangle<int> cell = getCellBounds (line);
+
+        if (((word >> line) & 1) != 0)
+            g.setColour (findColour (ThemeColours::defaultText));
+        else
+            g.setColour (getTTLLineColour (line));
+
+        g.fillRect (cell.getX(), cell.getY(), cell.getWidth(), 3);
+    }
+
+    if (hoveredLine >= 0)
+    {
+        const Rectangle<int> cell = getCellBounds (hoveredLine);
+
+        g.setColour (getTTLLineColour (hoveredLine));
+        g.drawLine (float (cell.getX()), float (cell.getBottom()), float (cell.getRight()), float (cell.getBottom()), 2.0f);
+    }
+}
+
+void TTLBitGrid::resized()
+{
+    renderImages();
+}
+
+void TTLBitGrid::lookAndFeelChanged()
+{
+    renderImages();
+    repaint();
+}
+
+void TTLBitGrid::mouseDown (const MouseEvent& event)
+{
+    const int line = getLineAt (event.getPosition());
+
+    if (clickable && line >= 0 && onLineClicked)
+        onLineClicked (line);
+}
+
+void TTLBitGrid::mouseMove (const MouseEvent& event)
+{
+    setHoveredLine (clickable ? getLineAt (event.getPosition()) : -1);
+}
+
+void TTLBitGrid::mouseExit (const MouseEvent&)
+{
+    setHoveredLine (-1);
+}
+
+void TTLBitGrid::setHoveredLine (int line)
+{
+    if (line == hoveredLine)
+        return;
+
+    // The underline sits on the cell's bottom edge, so repaint a pixel past it.
+    if (hoveredLine >= 0)
+        repaint (getCellBounds (hoveredLine).expanded (0, 1));
 
-    if (isHighlighted && getClickingTogglesState())
-        g.setColour (colour);
+    hoveredLine = line;
 
-    g.drawLine (0, getHeight(), getWidth(), getHeight(), 2.0);
+    if (hoveredLine >= 0)
+        repaint (getCellBounds (hoveredLine).expanded (0, 1));
 }
 
 //
-// GUI tray holding a small number of TTL banks.
+// Overview of every stream.
+
+// Private magic constants for overview geometry.
+// A row is a name, then eight banks of eight cells; it's exactly as wide as the bit grid.
+#define OVERVIEW_HEADER_YSIZE 11
+#define OVERVIEW_ROW_YSIZE 9
+#define OVERVIEW_NAME_XSIZE 64
+#define OVERVIEW_CELL_XPITCH 3
+#define OVERVIEW_BANK_XGAP 2
+#define OVERVIEW_BANK_XPITCH (TTLDEBUG_PANEL_BANK_BITS * OVERVIEW_CELL_XPITCH + OVERVIEW_BANK_XGAP)
 
 // Constructor.
-TTLPanelBaseEditor::TTLPanelBaseEditor (TTLPanelBase* newParent) : GenericEditor (newParent)
+TTLStreamOverview::TTLStreamOverview()
 {
-    parent = newParent;
+    setOpaque (false);
+}
 
-    Array<Colour> eventColours = {
-        Colour (224, 185, 36),
-        Colour (243, 119, 33),
-        Colour (237, 37, 36),
-        Colour (217, 46, 171),
-        Colour (101, 31, 255),
-        Colour (48, 117, 255),
-        Colour (116, 227, 156),
-        Colour (82, 173, 0)
-    };
+// Destructor.
+TTLStreamOverview::~TTLStreamOverview()
+{
+    // Nothing to do.
+}
+
+int TTLStreamOverview::getHeightForStreams (int numStreams)
+{
+    return OVERVIEW_HEADER_YSIZE + numStreams * OVERVIEW_ROW_YSIZE;
+}
+
+Rectangle<int> TTLStreamOverview::getRowBounds (int row) const
+{
+    return Rectangle<int> (0, OVERVIEW_HEADER_YSIZE + row * OVERVIEW_ROW_YSIZE, getWidth(), OVERVIEW_ROW_YSIZE);
+}
+
+Rectangle<int> TTLStreamOverview::getCellBounds (int row, int line) const
+{
+    const int bank = line / TTLDEBUG_PANEL_BANK_BITS;
+    const int x = OVERVIEW_NAME_XSIZE + bank * OVERVIEW_BANK_XPITCH + (line % TTLDEBUG_PANEL_BANK_BITS) * OVERVIEW_CELL_XPITCH;
 
-    for (int bidx = 0; bidx < TTLDEBUG_PANEL_UI_MAX_BUTTONS; bidx++)
+    return Rectangle<int> (x, OVERVIEW_HEADER_YSIZE + row * OVERVIEW_ROW_YSIZE + 1, OVERVIEW_CELL_XPITCH - 1, OVERVIEW_ROW_YSIZE - 2);
+}
+
+void TTLStreamOverview::setStreams (const std::vector<std::pair<uint16, String>>& streams)
+{
+    rows.clear();
+
+    for (auto& stream : streams)
     {
-        int row = bidx / TTLDEBUG_PANEL_UI_BUTTONS_PER_ROW;
-        int column = bidx % TTLDEBUG_PANEL_UI_BUTTONS_PER_ROW;
+        Row row;
+        row.streamId = stream.first;
+        row.name = stream.second;
+        rows.push_back (row);
+    }
+
+    setSize (OVERVIEW_NAME_XSIZE + TTLDEBUG_PANEL_MAX_BANKS * OVERVIEW_BANK_XPITCH, getHeightForStreams (int (rows.size())));
+    repaint();
+}
 
-        TTLPanelButton* button = new TTLPanelButton (bidx, eventColours[column]);
-        buttons.add (button);
+void TTLStreamOverview::setStates (const std::map<uint16, TTLDisplayState>& states)
+{
+    for (int row = 0; row < int (rows.size()); row++)
+    {
+        auto found = states.find (rows[row].streamId);
 
-        button->setBounds (BUTTONROW_XHALO + column * BITBUTTON_XPITCH,
-                           TITLEBAR_YOFFSET + row * BUTTONROW_YPITCH,
-                           BITBUTTON_XSIZE,
-                           BUTTONROW_YSIZE);
+        if (found == states.end() || found->second.word == rows[row].word)
+            continue;
 
-        addAndMakeVisible (button);
+        rows[row].word = found->second.word;
+        repaint (getRowBounds (row));
+    }
+}
 
-        if (parent->isEventSourcePanel())
+String TTLStreamOverview::getTooltip()
+{
+    const Point<int> position = getMouseXYRelative();
+    const int row = (position.y - OVERVIEW_HEADER_YSIZE) / OVERVIEW_ROW_YSIZE;
+
+    if (position.y < OVERVIEW_HEADER_YSIZE || row >= int (rows.size()))
+        return String();
+
+    return rows[row].name + ": 0x" + String::toHexString (int64 (rows[row].word));
+}
+
+void TTLStreamOverview::paint (Graphics& g)
+{
+    const Rectangle<int> clip = g.getClipBounds();
+
+    g.setColour (findColour (ThemeColours::defaultText));
+    g.setFont (10.0f);
+
+    if (clip.getY() < OVERVIEW_HEADER_YSIZE)
+    {
+        for (int bank = 0; bank < TTLDEBUG_PANEL_MAX_BANKS; bank++)
+            g.drawText (String::charToString (juce_wchar ('A' + bank)), OVERVIEW_NAME_XSIZE + bank * OVERVIEW_BANK_XPITCH, 0, OVERVIEW_BANK_XPITCH - OVERVIEW_BANK_XGAP, OVERVIEW_HEADER_YSIZE, Justification::centred);
+    }
+
+    for (int row = 0; row < int (rows.size()); row++)
+    {
+        const Rectangle<int> bounds = getRowBounds (row);
+
+        if (! bounds.intersects (clip))
+            continue;
+
+        g.setColour (findColour (ThemeColours::defaultText));
+        g.setFont (float (OVERVIEW_ROW_YSIZE));
+        g.drawText (rows[row].name, 0, bounds.getY(), OVERVIEW_NAME_XSIZE - 4, bounds.getHeight(), Justification::left);
+
+        for (int line = 0; line < TTLDEBUG_PANEL_TOTAL_BITS; line++)
         {
-            button->setClickingTogglesState (true);
-            button->addListener (this);
+            if (((rows[row].word >> line) & 1) != 0)
+                g.setColour (getTTLLineColour (line));
+            else
+                g.setColour (findColour (ThemeColours::widgetBackground));
+
+            g.fillRect (getCellBounds (row, line));
         }
-        else
+    }
+}
+
+//
+// Settings popup.
+
+#define SETTINGS_XHALO 10
+#define SETTINGS_ROW_XSIZE 200
+#define SETTINGS_ROW_YSIZE 18
+#define SETTINGS_ROW_YPITCH 22
+#define SETTINGS_HEADING_YSIZE 24
+#define SETTINGS_COLUMN_XPITCH (SETTINGS_ROW_XSIZE + SETTINGS_XHALO)
+
+// Constructor.
+TTLPanelSettings::TTLPanelSettings (TTLPanelBase* panel)
+{
+    enum EditorType
+    {
+        TextBoxRow,
+        ComboBoxRow,
+        ToggleRow,
+        PathRow
+    };
+
+    struct Row
+    {
+        const char* name;
+        EditorType type;
+    };
+
+    struct Section
+    {
+        const char* title;
+        int column;
+        std::vector<Row> rows;
+    };
+
+    // Toggle panel: replay and load are the big ones, so they get a column each.
+    const std::vector<Section> toggleSections = {
+        { "Replay", 0, { { "replay_file", PathRow }, { "replay_rate", TextBoxRow }, { "replay_loop", ToggleRow }, { "replay_seek", TextBoxRow } } },
+        { "Barcode", 0, { { "barcode_line", TextBoxRow }, { "barcode_bits", TextBoxRow }, { "barcode_bit_ms", TextBoxRow }, { "barcode_interval", TextBoxRow } } },
+        { "Display", 0, { { "word_groups", TextBoxRow } } },
+        { "Load", 1, { { "load_mode", ComboBoxRow }, { "load_rate", TextBoxRow }, { "load_lines", TextBoxRow }, { "load_streams", TextBoxRow }, { "load_burst", TextBoxRow }, { "load_gap", TextBoxRow }, { "load_seed", TextBoxRow } } },
+        { "Router", 1, { { "route_map", TextBoxRow }, { "route_logic", ComboBoxRow } } }
+    };
+
+    const std::vector<Section> displaySections = {
+        { "Input", 0, { { "log_transitions", ToggleRow }, { "debounce", TextBoxRow } } },
+        { "Display", 0, { { "word_groups", TextBoxRow } } },
+        { "Barcode Decoder", 1, { { "decode_line", TextBoxRow }, { "decode_bits", TextBoxRow }, { "decode_bit_ms", TextBoxRow } } }
+    };
+
+    const std::vector<Section>& sections = panel->isEventSourcePanel() ? toggleSections : displaySections;
+
+    // Settings the plugin only reads when acquisition starts are read-only while it's running, as they are in the editor.
+    const bool acquiring = CoreServices::getAcquisitionStatus();
+
+    int columnY[2] = { SETTINGS_XHALO, SETTINGS_XHALO };
+
+    for (auto& section : sections)
+    {
+        int y = addHeading (section.title, section.column, columnY[section.column]);
+
+        for (auto& row : section.rows)
         {
-            button->setToggleState (false, dontSendNotification);
+            Parameter* parameter = panel->getParameter (row.name);
+            std::unique_ptr<Component> editor;
+
+            if (row.type == PathRow)
+                editor = std::make_unique<PathParameterEditor> (parameter, SETTINGS_ROW_YSIZE, SETTINGS_ROW_XSIZE);
+            else if (row.type == ToggleRow)
+                editor = std::make_unique<ToggleParameterEditor> (parameter, SETTINGS_ROW_YSIZE, SETTINGS_ROW_XSIZE);
+            else if (row.type == ComboBoxRow)
+                editor = std::make_unique<ComboBoxParameterEditor> (parameter, SETTINGS_ROW_YSIZE, SETTINGS_ROW_XSIZE);
+            else
+                editor = std::make_unique<TextBoxParameterEditor> (parameter, SETTINGS_ROW_YSIZE, SETTINGS_ROW_XSIZE);
+
+            editor->setBounds (SETTINGS_XHALO + section.column * SETTINGS_COLUMN_XPITCH, y, SETTINGS_ROW_XSIZE, SETTINGS_ROW_YSIZE);
+            editor->setEnabled (! (acquiring && parameter->shouldDeactivateDuringAcquisition()));
+            addAndMakeVisible (editor.get());
+            contents.push_back (std::move (editor));
+
+            y += SETTINGS_ROW_YPITCH;
         }
+
+        columnY[section.column] = y;
     }
 
-    setDesiredWidth (260);
+    setSize (SETTINGS_XHALO + 2 * SETTINGS_COLUMN_XPITCH, jmax (columnY[0], columnY[1]) + SETTINGS_XHALO);
+}
+
+// Destructor.
+TTLPanelSettings::~TTLPanelSettings()
+{
+}
+
+int TTLPanelSettings::addHeading (const String& title, int column, int y)
+{
+    auto heading = std::make_unique<Label> (title + " Heading", title);
+    heading->setFont (FontOptions ("Inter", "Semi Bold", 14.0f));
+    heading->setBounds (SETTINGS_XHALO + column * SETTINGS_COLUMN_XPITCH, y, SETTINGS_ROW_XSIZE, SETTINGS_HEADING_YSIZE - 4);
+    addAndMakeVisible (heading.get());
+    contents.push_back (std::move (heading));
+
+    return y + SETTINGS_HEADING_YSIZE;
+}
+
+//
+// GUI tray holding a small number of TTL banks.
+
+// Constructor.
+TTLPanelBaseEditor::TTLPanelBaseEditor (TTLPanelBase* newParent) : VisualizerEditor (newParent, "TTL Chart")
+{
+    parent = newParent;
+
+    bitGrid = std::make_unique<TTLBitGrid>();
+    bitGrid->describeLine = [this] (int line)
+    {
+        const String details = parent->describeLine (getCurrentStream(), line);
+        const String groups = describeGroupLine (line);
+
+        return details.isEmpty() || groups.isEmpty() ? details + groups : details + "\n" + groups;
+    };
+    bitGrid->setBounds (BUTTONROW_XHALO, TITLEBAR_YOFFSET, BITGRID_XSIZE, BITGRID_YSIZE);
+    addAndMakeVisible (bitGrid.get());
+
+    // Shares the grid's space, and scrolls when there are more streams than fit.
+    overview = std::make_unique<TTLStreamOverview>();
+    overviewViewport = std::make_unique<Viewport>();
+    overviewViewport->setViewedComponent (overview.get(), false);
+    overviewViewport->setScrollBarsShown (true, false);
+    overviewViewport->setBounds (BUTTONROW_XHALO, TITLEBAR_YOFFSET, BITGRID_XSIZE + overviewViewport->getScrollBarThickness(), BITGRID_YSIZE);
+    addChildComponent (overviewViewport.get());
+
+    overviewButton = std::make_unique<UtilityButton> ("All");
+    overviewButton->addListener (this);
+    overviewButton->setRadius (3.0f);
+    overviewButton->setClickingTogglesState (true);
+    overviewButton->setTooltip ("Show every stream at once");
+    overviewButton->setBounds (WORDBOX_XOFFSET + 118, 75, 32, 18);
+    addAndMakeVisible (overviewButton.get());
+
+    if (parent->isEventSourcePanel())
+    {
+        bitGrid->setClickable (true);
+        bitGrid->onLineClicked = [this] (int line)
+        { lineClicked (line); };
+    }
+
+    // Everything but the pulse controls lives in a popup, so it doesn't widen the editor; see TTLPanelSettings.
+    settingsButton = std::make_unique<UtilityButton> ("Settings");
+    settingsButton->addListener (this);
+    settingsButton->setRadius (3.0f);
+    addAndMakeVisible (settingsButton.get());
 
-    editableLabel = std::make_unique<CustomTextBox> ("TTL Word", "0", "0123456789", "");
-    editableLabel->setFont (FontOptions ("CP Mono", "Plain", 14.0f));
-    editableLabel->setBounds (205, 50, 50, 18);
+    // Decimal, or hexadecimal with a "0x" prefix. "A=..." to "H=..." set one word group.
+    editableLabel = std::make_unique<CustomTextBox> ("TTL Word", "0", "0123456789abcdefghxABCDEFGHX=", "");
+    editableLabel->setFont (FontOptions ("CP Mono", "Plain", 12.0f));
+    editableLabel->setBounds (WORDBOX_XOFFSET, 50, WORDBOX_XSIZE, 18);
     addAndMakeVisible (editableLabel.get());
-    editableLabel->onTextChange = [this]
-    { editableLabel->setTooltip (editableLabel->getText()); };
 
     ttlWordLabel = std::make_unique<Label> ("Word Label", "Word");
     ttlWordLabel->setFont (FontOptions ("Inter", "Regular", 14.0f));
@@ -135,37 +575,75 @@ TTLPanelBaseEditor::TTLPanelBaseEditor (TTLPanelBase* newParent) : GenericEditor
         setButton = std::make_unique<UtilityButton> ("Set");
         setButton->addListener (this);
         setButton->setRadius (3.0f);
-        setButton->setBounds (210, 75, 40, 18);
+        setButton->setBounds (WORDBOX_XOFFSET, 75, 35, 18);
         addAndMakeVisible (setButton.get());
 
         clearButton = std::make_unique<UtilityButton> ("Clear");
         clearButton->addListener (this);
         clearButton->setRadius (3.0f);
-        clearButton->setBounds (210, 98, 40, 18);
+        clearButton->setBounds (WORDBOX_XOFFSET + 38, 75, 38, 18);
         addAndMakeVisible (clearButton.get());
+
+        setAllButton = std::make_unique<UtilityButton> ("Set all");
+        setAllButton->addListener (this);
+        setAllButton->setRadius (3.0f);
+        setAllButton->setTooltip ("Set this word on every stream at once");
+        setAllButton->setBounds (WORDBOX_XOFFSET, 100, 73, 18);
+        addAndMakeVisible (setAllButton.get());
+
+        addComboBoxParameterEditor (Parameter::PROCESSOR_SCOPE, "pulse_mode", CONTROLS_XOFFSET, 30);
+        addComboBoxParameterEditor (Parameter::PROCESSOR_SCOPE, "pulse_length", CONTROLS_XOFFSET, 78);
+
+        settingsButton->setTooltip ("Replay, barcode, load, router and word group settings");
+        settingsButton->setBounds (WORDBOX_XOFFSET + 77, 100, 73, 18);
+
+        setDesiredWidth (CONTROLS_XOFFSET + 90);
     }
+    else
+    {
+        settingsButton->setTooltip ("Transition log, debounce, word group and barcode decoder settings");
+        settingsButton->setBounds (WORDBOX_XOFFSET, 75, 76, 18);
+
+        setDesiredWidth (CONTROLS_XOFFSET);
+
+        // Latest barcode decoded from the selected stream.
+        barcodeLabel = std::make_unique<Label> ("Barcode Label", "Barcode: none");
+        barcodeLabel->setFont (FontOptions ("CP Mono", "Plain", 12.0f));
+        barcodeLabel->setBounds (WORDBOX_XOFFSET, 100, WORDBOX_XSIZE, 18);
+        addAndMakeVisible (barcodeLabel.get());
+    }
+
+#if TTLDEBUG_PANEL_INSTRUMENTATION
+    // Writes the hot-path counters to the log, and shows them as a tooltip.
+    perfButton = std::make_unique<UtilityButton> ("Perf");
+    perfButton->addListener (this);
+    perfButton->setRadius (3.0f);
+    perfButton->setBounds (WORDBOX_XOFFSET + 80, 75, 35, 18);
+    addAndMakeVisible (perfButton.get());
+#endif
+
+    // The plugin publishes state without blocking and never calls us; we poll, which costs one atomic load when nothing changed.
+    startTimer (TTLDEBUG_PANEL_DISPLAY_REFRESH_MS);
+    refreshFromProcessor();
 }
 
 // Destructor.
 TTLPanelBaseEditor::~TTLPanelBaseEditor()
 {
+    stopTimer();
+
     // "OwnedArray" and "ScopedPointer" take care of de-allocation for us.
 }
 
 void TTLPanelBaseEditor::startAcquisition()
 {
-    if (! parent->isEventSourcePanel())
-    {
-        startTimer (TTLDEBUG_PANEL_DISPLAY_REFRESH_MS);
-    }
+    // Starts the strip chart, if it's open.
+    VisualizerEditor::startAcquisition();
 }
 
 void TTLPanelBaseEditor::stopAcquisition()
 {
-    if (! parent->isEventSourcePanel())
-    {
-        stopTimer();
-    }
+    VisualizerEditor::stopAcquisition();
 
     for (auto stream : parent->getDataStreams())
     {
@@ -176,79 +654,113 @@ void TTLPanelBaseEditor::stopAcquisition()
 
 void TTLPanelBaseEditor::selectedStreamHasChanged()
 {
+    latchedLines = 0;
+    bitGrid->setLatched (latchedLines);
+
+    auto found = displayStates.find (getCurrentStream());
+
+    if (found != displayStates.end())
+        bitGrid->setActivity (found->second.activity);
+
     redrawAllButtons();
+    updateBarcodeLabel();
 }
 
-void TTLPanelBaseEditor::buttonClicked (Button* button)
+Visualizer* TTLPanelBaseEditor::createNewCanvas()
 {
-    if (! parent->isEventSourcePanel())
-        return;
+    return new TTLStripChartCanvas (parent);
+}
+
+void TTLPanelBaseEditor::updateSettings()
+{
+    std::vector<std::pair<uint16, String>> streams;
 
-    if (buttons.contains ((TTLPanelButton*) button))
+    for (auto& state : parent->getStreamStates())
     {
-        TTLPanelButton* panelButton = (TTLPanelButton*) button;
+        if (auto* stream = parent->getDataStream (state.streamId))
+            streams.push_back ({ state.streamId, stream->getName() });
+    }
 
-        if (panelButton->getToggleState())
-            currentTTLWord[getCurrentStream()] |= (1 << panelButton->getLine());
-        else
-            currentTTLWord[getCurrentStream()] &= ~(1 << panelButton->getLine());
+    overview->setStreams (streams);
+    overview->setStates (displayStates);
 
-        LOGD ("Current ttlWord: ", currentTTLWord[getCurrentStream()]);
+    if (canvas != nullptr)
+        canvas->updateSettings();
+}
 
-        IntParameter* ttlWordParam = getTTLWordParameter();
+void TTLPanelBaseEditor::setOverviewShown (bool shouldShowOverview)
+{
+    bitGrid->setVisible (! shouldShowOverview);
+    overviewViewport->setVisible (shouldShowOverview);
 
-        if (ttlWordParam != nullptr)
-        {
-            int64 valueI64 = int64 (currentTTLWord[getCurrentStream()]);
-            int converted = int (valueI64 - INT_MAX);
-            ttlWordParam->setNextValue (var (converted), false);
-        }
-        else
-        {
-            LOGD ("No parameter found.");
-        }
+    // The word box and its buttons still follow the selected stream.
+    if (shouldShowOverview)
+        overview->setStates (displayStates);
+}
 
-        editableLabel->setText (String (currentTTLWord[getCurrentStream()]), dontSendNotification);
+// Called by VisualizerEditor for buttons other than its own.
+void TTLPanelBaseEditor::buttonEvent (Button* button)
+{
+#if TTLDEBUG_PANEL_INSTRUMENTATION
+    if (button == perfButton.get())
+    {
+        parent->logInstrumentation();
+        perfButton->setTooltip (parent->getInstrumentationSummary());
+        return;
+    }
+#endif
+
+    if (button == overviewButton.get())
+    {
+        setOverviewShown (overviewButton->getToggleState());
+        return;
     }
-    else if (button == clearButton.get())
+
+    if (button == settingsButton.get())
+    {
+        CallOutBox::launchAsynchronously (std::make_unique<TTLPanelSettings> (parent), settingsButton->getScreenBounds(), nullptr);
+        return;
+    }
+
+    if (! parent->isEventSourcePanel())
+        return;
+
+    if (button == clearButton.get())
     {
         currentTTLWord[getCurrentStream()] = 0;
 
-        IntParameter* ttlWordParam = getTTLWordParameter();
+        setTTLWordParameter (currentTTLWord[getCurrentStream()]);
+
+        redrawAllButtons();
+    }
+    else if (button == setAllButton.get())
+    {
+        // A group assignment starts from this stream's word, and every stream gets the result.
+        uint64 candidateValue = currentTTLWord[getCurrentStream()];
 
-        if (ttlWordParam != nullptr)
+        if (parseWordBoxText (editableLabel->getText(), candidateValue))
         {
-            int64 valueI64 = int64 (currentTTLWord[getCurrentStream()]);
-            int converted = int (valueI64 - INT_MAX);
-            ttlWordParam->setNextValue (var (converted), false);
+            for (auto stream : parent->getDataStreams())
+                currentTTLWord[stream->getStreamId()] = candidateValue;
+
+            parent->setWordOnAllStreams (candidateValue);
+
+            redrawAllButtons();
         }
         else
         {
-            LOGD ("No parameter found.");
+            LOGD ("Invalid value.");
         }
-
-        redrawAllButtons();
     }
     else if (button == setButton.get())
     {
-        int candidateValue = editableLabel->getText().getIntValue();
+        uint64 candidateValue = currentTTLWord[getCurrentStream()];
 
-        if (candidateValue >= 0 && candidateValue <= INT_MAX)
+        if (parseWordBoxText (editableLabel->getText(), candidateValue))
         {
             currentTTLWord[getCurrentStream()] = candidateValue;
 
-            IntParameter* ttlWordParam = getTTLWordParameter();
-
-            if (ttlWordParam != nullptr)
-            {
-                int64 valueI64 = int64 (currentTTLWord[getCurrentStream()]);
-                int converted = int (valueI64 - INT_MAX);
-                ttlWordParam->setNextValue (var (converted), false);
-            }
-            else
-            {
-                LOGD ("No parameter found.");
-            }
+            setTTLWordParameter (currentTTLWord[getCurrentStream()]);
 
             redrawAllButtons();
         }
@@ -259,53 +771,270 @@ void TTLPanelBaseEditor::buttonClicked (Button* button)
     }
 }
 
-IntParameter* TTLPanelBaseEditor::getTTLWordParameter()
+void TTLPanelBaseEditor::lineClicked (int line)
+{
+    // In pulse mode, a click leaves the resting word alone and asks the plugin for a pulse.
+    CategoricalParameter* modeParam = (CategoricalParameter*) parent->getParameter ("pulse_mode");
+
+    if (modeParam != nullptr && modeParam->getSelectedIndex() != 0)
+    {
+        CategoricalParameter* lengthParam = (CategoricalParameter*) parent->getParameter ("pulse_length");
+        float lengthMs = lengthParam != nullptr ? lengthParam->getSelectedString().getFloatValue() : 100.0f;
+
+        parent->triggerPulse (getCurrentStream(), line, modeParam->getSelectedIndex() == 1, lengthMs);
+        return;
+    }
+
+    // Start from the parameter, not the last snapshot; the snapshot may lag the previous click.
+    if (Parameter* ttlWordParam = getTTLWordParameter())
+        currentTTLWord[getCurrentStream()] = TTLPanelBase::wordFromParameterValue (ttlWordParam->getValue());
+
+    currentTTLWord[getCurrentStream()] ^= (uint64 (1) << line);
+
+    LOGD ("Current ttlWord: ", currentTTLWord[getCurrentStream()]);
+
+    setTTLWordParameter (currentTTLWord[getCurrentStream()]);
+
+    redrawAllButtons();
+}
+
+Parameter* TTLPanelBaseEditor::getTTLWordParameter()
 {
     if (auto* stream = parent->getDataStream (getCurrentStream()))
     {
         // Get the TTL word parameter for the current stream.
-        return (IntParameter*) stream->getParameter ("ttl_word");
+        return stream->getParameter ("ttl_word");
     }
 
     return nullptr;
 }
 
-// Timer callback.
-void TTLPanelBaseEditor::timerCallback()
+void TTLPanelBaseEditor::setTTLWordParameter (uint64 word)
 {
+    Parameter* ttlWordParam = getTTLWordParameter();
+
+    if (ttlWordParam != nullptr)
+        ttlWordParam->setNextValue (var (TTLPanelBase::wordToParameterValue (word)), false);
+    else
+        LOGD ("No parameter found.");
+}
+
+// Picks up whatever the plugin published since the last call.
+void TTLPanelBaseEditor::refreshFromProcessor()
+{
+    updateWordGroups();
+
+    if (! parent->pullStateFromProcessor (displayStates))
+        return;
+
+    for (auto& entry : displayStates)
+        currentTTLWord[entry.first] = entry.second.word;
+
+    updateLatches();
     redrawAllButtons();
+    updateBarcodeLabel();
+
+    // Every stream comes from the same snapshot, so the rows are always consistent with each other.
+    if (overviewViewport->isVisible())
+        overview->setStates (displayStates);
 }
 
-// Accessor to push plugin state to the editor.
-void TTLPanelBaseEditor::pushStateToEditor (std::map<uint16, uint32> currentTTLWord_)
+// A line with one edge since the last update shows it as a state change.
+// Two or more edges mean a pulse came and went in between, so the line gets marked for a while.
+void TTLPanelBaseEditor::updateLatches()
 {
-    currentTTLWord = currentTTLWord_;
+    const uint16 currentStream = getCurrentStream();
+    uint64 missed = 0;
 
-    if (parent->isEventSourcePanel())
+    for (auto& entry : displayStates)
     {
-        redrawAllButtons();
+        const TTLLineActivity& now = entry.second.activity;
+        TTLLineActivity& before = previousActivity[entry.first];
+
+        // Counts start over whenever the plugin rebuilds its streams.
+        if (entry.first == currentStream && now.totalEdges >= before.totalEdges)
+        {
+            for (int line = 0; line < TTLDEBUG_PANEL_UI_MAX_BUTTONS; line++)
+            {
+                const uint32 edges = (now.risingEdges[line] - before.risingEdges[line])
+                                     + (now.fallingEdges[line] - before.fallingEdges[line]);
+
+                if (edges >= 2)
+                    missed |= (uint64 (1) << line);
+            }
+        }
+
+        before = now;
+
+        if (entry.first == currentStream)
+            bitGrid->setActivity (now);
+    }
+
+    if (missed != 0)
+    {
+        latchedLines |= missed;
+        latchedAtMs = Time::getMillisecondCounter();
+        bitGrid->setLatched (latchedLines);
     }
 }
 
-// Redraw function. Should be called from the timer, not the plugin.
+// Timer callback.
+void TTLPanelBaseEditor::timerCallback()
+{
+    refreshFromProcessor();
+
+    if (latchedLines != 0 && Time::getMillisecondCounter() - latchedAtMs >= TTLDEBUG_PANEL_LATCH_HOLD_MS)
+    {
+        latchedLines = 0;
+        bitGrid->setLatched (latchedLines);
+    }
+}
+
+// Redraw function. Should be called from the message thread, not the plugin.
+// Nothing is done if the word didn't change; otherwise the grid repaints only the cells that changed.
 void TTLPanelBaseEditor::redrawAllButtons()
 {
-    // Wrap the row update function.
-    // Pass the "acquisitionIsActive" state variable from GenericEditor.
+    const uint16 stream = getCurrentStream();
+    const uint64 state = currentTTLWord[stream];
+
+    if (drawnValid && stream == drawnStream && state == drawnTTLWord)
+        return;
 
-    uint32 state = currentTTLWord[getCurrentStream()];
+    drawnTTLWord = state;
+    drawnStream = stream;
+    drawnValid = true;
 
-    for (int bidx = 0; bidx < TTLDEBUG_PANEL_UI_MAX_BUTTONS; bidx++)
+    bitGrid->setWord (state);
+
+    editableLabel->setText (String (state), dontSendNotification);
+    editableLabel->setTooltip (describeWord (state));
+}
+
+// Groups are lettered in the order they're listed, one letter per bank at most.
+void TTLPanelBaseEditor::updateWordGroups()
+{
+    Parameter* groupsParam = parent->getParameter ("word_groups");
+    const String source = groupsParam != nullptr ? groupsParam->getValue().toString() : String();
+
+    if (source == wordGroupsSource)
+        return;
+
+    wordGroupsSource = source;
+    wordGroups.clear();
+    wordGroupTexts.clear();
+
+    StringArray groupTexts = StringArray::fromTokens (source, ";", "");
+    groupTexts.trim();
+    groupTexts.removeEmptyStrings();
+
+    for (auto groupText : groupTexts)
     {
-        buttons[bidx]->setToggleState ((state >> bidx) & 1, dontSendNotification);
-        buttons[bidx]->repaint();
+        if (int (wordGroups.size()) == TTLDEBUG_PANEL_MAX_BANKS)
+        {
+            CoreServices::sendStatusMessage (parent->getName() + ": only the first " + String (TTLDEBUG_PANEL_MAX_BANKS) + " word groups are used");
+            break;
+        }
+
+        TTLBitGroup group;
+        String error;
+
+        if (! group.parse (groupText, error))
+        {
+            CoreServices::sendStatusMessage (parent->getName() + ": " + error);
+            continue;
+        }
+
+        wordGroups.push_back (group);
+        wordGroupTexts.add (groupText);
     }
 
-    editableLabel->setText (String (currentTTLWord[getCurrentStream()]), dontSendNotification);
-    editableLabel->setTooltip (editableLabel->getText());
+    // The word box tooltip shows the group values.
+    drawnValid = false;
+    redrawAllButtons();
 }
 
-//
-// NOTE - Visualizer canvas holding a large number of TTL banks could go here.
+String TTLPanelBaseEditor::describeWord (uint64 word) const
+{
+    String description = "0x" + String::toHexString (int64 (word));
+
+    for (int index = 0; index < int (wordGroups.size()); index++)
+    {
+        const uint64 value = wordGroups[size_t (index)].extract (word);
+
+        description += "\n" + String::charToString (juce_wchar ('A' + index)) + " (" + wordGroupTexts[index] + "): "
+                       + String (value) + " = 0x" + String::toHexString (int64 (value));
+    }
+
+    return description;
+}
+
+// Only runs for a tooltip, so a search through each group's lines is fine.
+String TTLPanelBaseEditor::describeGroupLine (int line) const
+{
+    const uint64 lineBit = uint64 (1) << line;
+    const uint64 word = currentTTLWord.count (drawnStream) != 0 ? currentTTLWord.at (drawnStream) : 0;
+    StringArray descriptions;
+
+    for (int index = 0; index < int (wordGroups.size()); index++)
+    {
+        const TTLBitGroup& group = wordGroups[size_t (index)];
+
+        if ((group.getMask() & lineBit) == 0)
+            continue;
+
+        for (int bit = 0; bit < group.getNumLines(); bit++)
+        {
+            if (group.getLine (bit) == line)
+                descriptions.add ("Group " + String::charToString (juce_wchar ('A' + index)) + " bit " + String (bit)
+                                  + ", group value " + String (group.extract (word)));
+        }
+    }
+
+    return descriptions.joinIntoString ("\n");
+}
+
+// "word" holds the current word on entry, so a group assignment leaves the other lines as they are.
+bool TTLPanelBaseEditor::parseWordBoxText (const String& text, uint64& word) const
+{
+    if (! text.containsChar ('='))
+        return parseTTLWord (text, word);
+
+    const String name = text.upToFirstOccurrenceOf ("=", false, false).trim().toUpperCase();
+    const int index = name.length() == 1 ? int (name[0] - 'A') : -1;
+    uint64 value = 0;
+
+    if (index < 0 || index >= int (wordGroups.size()))
+        return false;
+
+    if (! parseTTLWord (text.fromFirstOccurrenceOf ("=", false, false).trim(), value))
+        return false;
+
+    const TTLBitGroup& group = wordGroups[size_t (index)];
+    word = (word & ~group.getMask()) | group.deposit (value);
+
+    return true;
+}
+
+// Display panels only. Shows the value and start sample of the selected stream's latest barcode.
+void TTLPanelBaseEditor::updateBarcodeLabel()
+{
+    if (barcodeLabel == nullptr)
+        return;
+
+    auto found = displayStates.find (getCurrentStream());
+
+    if (found == displayStates.end() || found->second.barcode.count == 0)
+    {
+        barcodeLabel->setText ("Barcode: none", dontSendNotification);
+        barcodeLabel->setTooltip (String());
+        return;
+    }
+
+    const TTLBarcodeReading& barcode = found->second.barcode;
+
+    barcodeLabel->setText ("Barcode: " + String (barcode.value), dontSendNotification);
+    barcodeLabel->setTooltip ("0x" + String::toHexString (int64 (barcode.value)) + ", starting at sample " + String (barcode.startSample)
+                              + "; " + String (barcode.count) + " decoded this run");
+}
 
 // This is the end of the file.
@@ -1,54 +1,160 @@
 #ifndef TTLDEBUGPANELBASEEDITOR_H_DEFINED
 #define TTLDEBUGPANELBASEEDITOR_H_DEFINED
 
-#include <EditorHeaders.h>
+#include <VisualizerEditorHeaders.h>
+
+#include "PanelBase.h"
 
 // Magic constants for GUI geometry.
-#define TTLDEBUG_PANEL_UI_MAX_BUTTONS 32
-#define TTLDEBUG_PANEL_UI_BUTTONS_PER_ROW 8
+#define TTLDEBUG_PANEL_UI_MAX_BUTTONS 64
+#define TTLDEBUG_PANEL_UI_BUTTONS_PER_ROW 16
 
 // Magic constants for GUI colours.
 #define TTLDEBUG_PANEL_DISABLED_COLOR juce::Colours::transparentWhite
 #define TTLDEBUG_PANEL_BITZERO_COLOR juce::Colours::grey
 #define TTLDEBUG_PANEL_BITONE_COLOR juce::Colours::lime
 
-// Magic constants for display refresh.
-#define TTLDEBUG_PANEL_DISPLAY_REFRESH_MS 50
+// How long a line stays marked after a pulse too short to see.
+#define TTLDEBUG_PANEL_LATCH_HOLD_MS 500
 
 namespace TTLDebugTools
 {
 class TTLPanelBase;
 
-// One TTL toggle button
-class TTLPanelButton : public Button
+// Display colour of a TTL line. Shared by the panels and the strip chart.
+Colour getTTLLineColour (int line);
+
+// The whole grid of TTL indicators, as one component.
+// Both cell states are pre-rendered, labels included, so painting is only image blits.
+class TTLBitGrid : public Component,
+                   public TooltipClient
 {
 public:
     // Constructor
-    TTLPanelButton (int line, Colour colour);
+    TTLBitGrid();
 
     // Destructor
-    ~TTLPanelButton();
+    ~TTLBitGrid();
 
-    // Returns the ttl line
-    int getLine()
+    // Shows "word". Only cells whose bit changed are repainted.
+    void setWord (uint64 word);
+
+    uint64 getWord() const
     {
-        return line;
+        return word;
     }
 
-    // Draw the button
-    void paintButton (Graphics& g, bool isHighlighted, bool isDown);
+    // Marks lines that pulsed without the change being visible.
+    void setLatched (uint64 mask);
+
+    // Edge counts shown in each cell's tooltip.
+    void setActivity (const TTLLineActivity& newActivity);
+
+    // Optional extra tooltip text for a line.
+    std::function<String (int line)> describeLine;
+
+    // Enables clicks and hover highlighting.
+    void setClickable (bool shouldBeClickable);
+
+    // Called with the (zero-based) line of a clicked cell.
+    std::function<void (int line)> onLineClicked;
+
+    // Returns the cell under a point, or -1 if the point falls between cells.
+    int getLineAt (Point<int> position) const;
+
+    // Returns the bounds of a line's cell.
+    Rectangle<int> getCellBounds (int line) const;
+
+    // Component callbacks.
+    String getTooltip() override;
+    void paint (Graphics& g) override;
+    void resized() override;
+    void lookAndFeelChanged() override;
+    void mouseDown (const MouseEvent& event) override;
+    void mouseMove (const MouseEvent& event) override;
+    void mouseExit (const MouseEvent& event) override;
 
 private:
-    int line;
-    Colour colour;
+    // Re-renders both cached images.
+    void renderImages();
+
+    void setHoveredLine (int line);
+
+    Image offImage;
+    Image onImage;
+    uint64 word = 0;
+    uint64 latched = 0;
+    TTLLineActivity activity;
+    int hoveredLine = -1;
+    bool clickable = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TTLBitGrid);
+};
+
+// Every stream's word at once, one compact row per stream, with the banks lettered A, B, ... across the top.
+// Rows are only repainted when their word changes.
+class TTLStreamOverview : public Component,
+                          public TooltipClient
+{
+public:
+    // Constructor
+    TTLStreamOverview();
+
+    // Destructor
+    ~TTLStreamOverview();
+
+    // Sets the rows, in slot order, and resizes to fit them.
+    void setStreams (const std::vector<std::pair<uint16, String>>& streams);
+
+    // Shows the words from one batched snapshot of every stream.
+    void setStates (const std::map<uint16, TTLDisplayState>& states);
+
+    // Height needed for "numStreams" rows.
+    static int getHeightForStreams (int numStreams);
+
+    // Component callbacks.
+    String getTooltip() override;
+    void paint (Graphics& g) override;
+
+private:
+    struct Row
+    {
+        uint16 streamId = 0;
+        String name;
+        uint64 word = 0;
+    };
+
+    Rectangle<int> getRowBounds (int row) const;
+    Rectangle<int> getCellBounds (int row, int line) const;
+
+    std::vector<Row> rows;
 
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TTLPanelButton);
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TTLStreamOverview);
 };
 
-// GUI tray holding a small number of TTL banks.
+// The panel settings that don't need to be on hand, shown in a popup so they don't widen the editor.
+// Settings the plugin only reads when acquisition starts are read-only while it's running, as they are in the editor.
+class TTLPanelSettings : public Component
+{
+public:
+    // Constructor
+    TTLPanelSettings (TTLPanelBase* panel);
+
+    // Destructor
+    ~TTLPanelSettings();
+
+private:
+    // Adds a section heading at "y" in "column", and returns the y of its first row.
+    int addHeading (const String& title, int column, int y);
+
+    std::vector<std::unique_ptr<Component>> contents;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TTLPanelSettings);
+};
+
+// GUI tray holding a small number of TTL banks, with a strip chart of all of them in the visualizer tab.
 // NOTE - GenericEditor already inherits from Timer.
-class TTLPanelBaseEditor : public GenericEditor,
-                           public Button::Listener,
+class TTLPanelBaseEditor : public VisualizerEditor,
                            public Timer
 {
 public:
@@ -58,7 +164,10 @@ public:
     /** Destructor */
     ~TTLPanelBaseEditor();
 
-    /** Timer hooks */
+    /** Pulls the latest state published by the plugin, if there is any */
+    void refreshFromProcessor();
+
+    /** Timer hooks. Polls the plugin every TTLDEBUG_PANEL_DISPLAY_REFRESH_MS, and clears pulse marks once they've been shown for long enough. */
     void timerCallback();
 
     /** Called at start of acquisition*/
@@ -68,34 +177,84 @@ public:
     void stopAcquisition() override;
 
     /** Button callback*/
-    void buttonClicked (Button* button);
+    void buttonEvent (Button* button) override;
+
+    /** Creates the strip chart */
+    Visualizer* createNewCanvas() override;
+
+    /** Passes new stream settings on to the strip chart */
+    void updateSettings() override;
 
     /** Called when selected stream is updated */
     void selectedStreamHasChanged() override;
 
-    /** The plugin has to push data to us, rather than us pulling it. */
-    void pushStateToEditor (std::map<uint16, uint32> currentTTLWord);
-
-    /** Redraws TTL indicators*/
+    /** Redraws the TTL indicators that changed since the last redraw */
     void redrawAllButtons();
 
+    /** Toggles or pulses a line, according to the pulse mode */
+    void lineClicked (int line);
+
+    /** Marks lines that pulsed more than once since the last update */
+    void updateLatches();
+
+    /** Shows the selected stream's latest decoded barcode */
+    void updateBarcodeLabel();
+
+    /** Re-reads the word groups if the parameter changed since the last call */
+    void updateWordGroups();
+
+    /** The word in hexadecimal, then the value of each word group */
+    String describeWord (uint64 word) const;
+
+    /** The word groups a line belongs to, and its bit in each */
+    String describeGroupLine (int line) const;
+
+    /** Parses the word box: a whole word, or "A=value" to change only group A of "word" */
+    bool parseWordBoxText (const String& text, uint64& word) const;
+
+    /** Switches between the selected stream's grid and the overview of every stream */
+    void setOverviewShown (bool shouldShowOverview);
+
     /** Gets the relevant parameter from the parent */
-    IntParameter* getTTLWordParameter();
+    Parameter* getTTLWordParameter();
+
+    /** Sends a new word for the current stream to the parent */
+    void setTTLWordParameter (uint64 word);
 
 private:
     TTLPanelBase* parent;
-    OwnedArray<TTLPanelButton> buttons;
+    std::unique_ptr<TTLBitGrid> bitGrid;
+    std::unique_ptr<TTLStreamOverview> overview;
+    std::unique_ptr<Viewport> overviewViewport;
+    std::unique_ptr<UtilityButton> overviewButton;
     std::unique_ptr<Label> ttlWordLabel;
     std::unique_ptr<CustomTextBox> editableLabel;
     std::unique_ptr<UtilityButton> setButton;
     std::unique_ptr<UtilityButton> clearButton;
-    std::map<uint16, uint32> currentTTLWord;
-    std::map<uint16, uint32> lastTTLWord;
+    std::unique_ptr<UtilityButton> setAllButton;
+    std::unique_ptr<Label> barcodeLabel;
+    std::unique_ptr<UtilityButton> settingsButton;
+#if TTLDEBUG_PANEL_INSTRUMENTATION
+    std::unique_ptr<UtilityButton> perfButton;
+#endif
+    std::map<uint16, uint64> currentTTLWord;
+    std::map<uint16, TTLDisplayState> displayStates;
+    std::map<uint16, TTLLineActivity> previousActivity;
+    uint64 latchedLines = 0;
+    uint32 latchedAtMs = 0;
+
+    // Parsed from the "word_groups" parameter; group A first.
+    std::vector<TTLBitGroup> wordGroups;
+    StringArray wordGroupTexts;
+    String wordGroupsSource;
+
+    // What the buttons and text box currently show.
+    uint64 drawnTTLWord = 0;
+    uint16 drawnStream = 0;
+    bool drawnValid = false;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TTLPanelBaseEditor);
 };
-
-// NOTE - Visualizer canvas holding a large number of TTL banks could go here.
 } // namespace TTLDebugTools
 
 #endif
@@ -0,0 +1,397 @@
+#include "PatternGenerator.h"
+#include "PatternGeneratorEditor.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace TTLDebugTools;
+
+// Constructor.
+TTLPatternGenerator::TTLPatternGenerator() : TTLPanelBase ("TTL Pattern Generator", true)
+{
+    outputChannelDescription = "Triggers whenever the generated pattern changes.";
+    outputChannelIdentifier = "patterngenerator.ttl";
+}
+
+// Destructor.
+TTLPatternGenerator::~TTLPatternGenerator()
+{
+}
+
+void TTLPatternGenerator::registerParameters()
+{
+    TTLPanelBase::registerParameters();
+
+    addStringParameter (Parameter::PROCESSOR_SCOPE,
+                        "pattern",
+                        "Pattern",
+                        "Groups of lines and the words each group steps through, e.g. \"1-4: 1 2 4 8; 5: 1 0\"",
+                        "1: 1 0",
+                        true);
+
+    addFloatParameter (Parameter::PROCESSOR_SCOPE,
+                       "period",
+                       "Period",
+                       "Time taken by every group to play its whole sequence",
+                       "ms",
+                       100.0f,
+                       0.1f,
+                       600000.0f,
+                       0.1f,
+                       true);
+
+    addCategoricalParameter (Parameter::PROCESSOR_SCOPE,
+                             "trigger_mode",
+                             "Trigger",
+                             "What starts the pattern",
+                             { "One-shot", "Hold", "TTL rise", "TTL fall", "TTL high", "TTL low" },
+                             ManualOneShot,
+                             false);
+
+    addIntParameter (Parameter::PROCESSOR_SCOPE,
+                     "trigger_line",
+                     "Input",
+                     "Input TTL line used by the TTL trigger modes",
+                     1,
+                     1,
+                     TTLDEBUG_PANEL_TOTAL_BITS,
+                     false);
+}
+
+AudioProcessorEditor* TTLPatternGenerator::createEditor()
+{
+    editor = std::make_unique<TTLPatternGeneratorEditor> (this);
+    return editor.get();
+}
+
+void TTLPatternGenerator::updateSettings()
+{
+    TTLPanelBase::updateSettings();
+
+    patternStates.clear();
+    patternStates.resize (streamStates.size());
+
+    parameterValueChanged (getParameter ("trigger_mode"));
+    parameterValueChanged (getParameter ("trigger_line"));
+
+    compilePatterns();
+}
+
+bool TTLPatternGenerator::stopAcquisition()
+{
+    for (auto& state : streamStates)
+    {
+        state.overlayMask = 0;
+        patternStates[state.slot].running = false;
+        patternStates[state.slot].held = false;
+    }
+
+    return TTLPanelBase::stopAcquisition();
+}
+
+TTLPatternGenerator::TriggerMode TTLPatternGenerator::getTriggerMode()
+{
+    return triggerMode;
+}
+
+void TTLPatternGenerator::parameterValueChanged (Parameter* parameter)
+{
+    if (parameter == nullptr)
+        return;
+
+    const String name = parameter->getName();
+
+    if (name == "pattern" || name == "period")
+    {
+        compilePatterns();
+    }
+    else if (name == "trigger_mode")
+    {
+        triggerMode = TriggerMode (((CategoricalParameter*) parameter)->getSelectedIndex());
+    }
+    else if (name == "trigger_line")
+    {
+        triggerLine = int (parameter->getValue()) - 1;
+    }
+    else
+    {
+        TTLPanelBase::parameterValueChanged (parameter);
+    }
+}
+
+// Pattern text is "lines: word word ...; lines: word word ...".
+// Each group's steps are spaced evenly over the period, and all groups are merged into one table.
+void TTLPatternGenerator::compilePatterns()
+{
+    struct GroupSequence
+    {
+        TTLBitGroup group;
+        Array<uint64> words;
+    };
+
+    std::vector<GroupSequence> sequences;
+    Parameter* patternParam = getParameter ("pattern");
+    Parameter* periodParam = getParameter ("period");
+
+    lastError = String();
+    patternMask = 0;
+
+    if (patternParam == nullptr || periodParam == nullptr)
+        return;
+
+    StringArray groupTexts = StringArray::fromTokens (patternParam->getValue().toString(), ";", "");
+    groupTexts.trim();
+    groupTexts.removeEmptyStrings();
+
+    for (auto groupText : groupTexts)
+    {
+        GroupSequence sequence;
+        String error;
+
+        if (! sequence.group.parse (groupText.upToFirstOccurrenceOf (":", false, false), error))
+        {
+            lastError = error;
+            break;
+        }
+
+        if ((patternMask & sequence.group.getMask()) != 0)
+        {
+            lastError = "lines in \"" + groupText + "\" belong to another group";
+            break;
+        }
+
+        StringArray wordTexts = StringArray::fromTokens (groupText.fromFirstOccurrenceOf (":", false, false), " ,", "");
+        wordTexts.removeEmptyStrings();
+
+        for (auto wordText : wordTexts)
+        {
+            uint64 word;
+
+            if (! parseTTLWord (wordText, word))
+            {
+                lastError = "bad word \"" + wordText + "\"";
+                break;
+            }
+
+            sequence.words.add (word);
+        }
+
+        if (lastError.isEmpty() && sequence.words.size() == 0)
+            lastError = "no words in \"" + groupText + "\"";
+
+        if (lastError.isNotEmpty())
+            break;
+
+        patternMask |= sequence.group.getMask();
+        sequences.push_back (sequence);
+    }
+
+    if (lastError.isNotEmpty())
+    {
+        LOGE (getName(), ": ", lastError);
+        CoreServices::sendStatusMessage (getName() + ": " + lastError);
+        sequences.clear();
+        patternMask = 0;
+    }
+
+    const double periodMs = double (periodParam->getValue());
+
+    for (auto& state : streamStates)
+    {
+        PatternStreamState& pattern = patternStates[state.slot];
+
+        pattern.table.clear();
+        pattern.periodSamples = jmax (int64 (1), int64 (std::llround (periodMs * 0.001 * state.sampleRate)));
+
+        // Gather every group step as (offset, group, step), then merge steps that share a sample.
+        std::vector<std::pair<int64, std::pair<int, int>>> steps;
+
+        for (int groupIndex = 0; groupIndex < int (sequences.size()); groupIndex++)
+        {
+            const int numSteps = sequences[groupIndex].words.size();
+
+            for (int step = 0; step < numSteps; step++)
+                steps.push_back ({ step * pattern.periodSamples / numSteps, { groupIndex, step } });
+        }
+
+        std::stable_sort (steps.begin(), steps.end(), [] (const auto& a, const auto& b)
+                          { return a.first < b.first; });
+
+        uint64 word = 0;
+
+        for (auto& step : steps)
+        {
+            const GroupSequence& sequence = sequences[step.second.first];
+
+            word = (word & ~sequence.group.getMask()) | sequence.group.deposit (sequence.words[step.second.second]);
+
+            if (! pattern.table.empty() && pattern.table.back().offset == step.first)
+                pattern.table.back().word = word;
+            else
+                pattern.table.push_back ({ step.first, word });
+        }
+    }
+}
+
+void TTLPatternGenerator::sendManualCommand (TTLPanelCommand::Type type)
+{
+    if (! CoreServices::getAcquisitionStatus())
+        return;
+
+    // One command, so every stream starts in the same block.
+    TTLPanelCommand command;
+    command.type = type;
+    command.requestTicks = Time::getHighResolutionTicks();
+    command.allStreams = true;
+
+    queueCommand (command);
+}
+
+void TTLPatternGenerator::process (AudioBuffer<float>& buffer)
+{
+    TTLDEBUG_INSTRUMENT (beginInstrumentedBlock();)
+
+    for (auto& pattern : patternStates)
+    {
+        pattern.numTriggers = 0;
+        pattern.nextTrigger = 0;
+    }
+
+    // handleTTLEvent() only records trigger edges. Our own events are added afterwards,
+    // once the input buffer has been walked.
+    if (triggerMode >= TTLRising)
+        checkForEvents();
+
+    TTLPanelBase::process (buffer);
+
+    TTLDEBUG_INSTRUMENT (endInstrumentedBlock();)
+}
+
+void TTLPatternGenerator::handleTTLEvent (TTLEventPtr event)
+{
+    TTLDEBUG_INSTRUMENT (countReceivedEvent();)
+
+    if (event->getLine() != triggerLine)
+        return;
+
+    TTLStreamState* state = getStreamState (event->getStreamId());
+
+    if (state == nullptr)
+        return;
+
+    PatternStreamState& pattern = patternStates[state->slot];
+
+    if (pattern.numTriggers < TTLDEBUG_PATTERN_MAX_TRIGGERS_PER_BLOCK)
+        pattern.triggers[pattern.numTriggers++] = { event->getSampleNumber(), event->getState() };
+}
+
+void TTLPatternGenerator::applyCommand (TTLStreamState& state, const TTLPanelCommand& command, int64 sampleNumber)
+{
+    if (command.type == TTLPanelCommand::Trigger || command.type == TTLPanelCommand::Hold || command.type == TTLPanelCommand::Release)
+        applyTrigger (state, command.type, sampleNumber);
+    else
+        TTLPanelBase::applyCommand (state, command, sampleNumber);
+}
+
+// A running sequence always completes; triggers only start it, or decide whether it repeats.
+void TTLPatternGenerator::applyTrigger (TTLStreamState& state, TTLPanelCommand::Type type, int64 sampleNumber)
+{
+    PatternStreamState& pattern = patternStates[state.slot];
+
+    if (type == TTLPanelCommand::Hold)
+        pattern.held = true;
+    else if (type == TTLPanelCommand::Release)
+        pattern.held = false;
+
+    if (type != TTLPanelCommand::Release && ! pattern.running && ! pattern.table.empty())
+    {
+        pattern.running = true;
+        pattern.cycleStart = sampleNumber;
+        pattern.cursor = 0;
+        state.overlayMask = patternMask;
+    }
+}
+
+void TTLPatternGenerator::applyTriggerEdge (TTLStreamState& state, const TriggerEdge& edge)
+{
+    switch (triggerMode)
+    {
+        case TTLRising:
+            if (edge.level)
+                applyTrigger (state, TTLPanelCommand::Trigger, edge.sampleNumber);
+            break;
+
+        case TTLFalling:
+            if (! edge.level)
+                applyTrigger (state, TTLPanelCommand::Trigger, edge.sampleNumber);
+            break;
+
+        case TTLHigh:
+            applyTrigger (state, edge.level ? TTLPanelCommand::Hold : TTLPanelCommand::Release, edge.sampleNumber);
+            break;
+
+        case TTLLow:
+            applyTrigger (state, edge.level ? TTLPanelCommand::Release : TTLPanelCommand::Hold, edge.sampleNumber);
+            break;
+
+        default:
+            break;
+    }
+}
+
+// Walks the transition table and the trigger edges together, in sample order.
+// Per-block cost depends only on the number of transitions in the block, not on the pattern length.
+void TTLPatternGenerator::advanceStream (TTLStreamState& state, int64 sampleNumber)
+{
+    PatternStreamState& pattern = patternStates[state.slot];
+
+    while (true)
+    {
+        int64 nextStep = INT64_MAX;
+        int64 nextTrigger = INT64_MAX;
+
+        if (pattern.running)
+        {
+            if (pattern.cursor < pattern.table.size())
+                nextStep = pattern.cycleStart + pattern.table[pattern.cursor].offset;
+            else
+                nextStep = pattern.cycleStart + pattern.periodSamples;
+        }
+
+        if (pattern.nextTrigger < pattern.numTriggers)
+            nextTrigger = pattern.triggers[pattern.nextTrigger].sampleNumber;
+
+        const int64 next = jmin (nextStep, nextTrigger);
+
+        if (next >= sampleNumber)
+            break;
+
+        TTLPanelBase::advanceStream (state, next);
+
+        if (nextStep <= nextTrigger)
+        {
+            if (pattern.cursor < pattern.table.size())
+            {
+                state.overlayBits = pattern.table[pattern.cursor++].word;
+            }
+            else if (pattern.held)
+            {
+                pattern.cycleStart += pattern.periodSamples;
+                pattern.cursor = 0;
+                continue;
+            }
+            else
+            {
+                pattern.running = false;
+                state.overlayMask = 0;
+            }
+
+            emitWord (state, getBlockOffset (state, next));
+        }
+        else
+        {
+            applyTriggerEdge (state, pattern.triggers[pattern.nextTrigger++]);
+        }
+    }
+
+    TTLPanelBase::advanceStream (state, sampleNumber);
+}
@@ -0,0 +1,126 @@
+#ifndef TTLDEBUGPATTERNGENERATOR_H_DEFINED
+#define TTLDEBUGPATTERNGENERATOR_H_DEFINED
+
+#include "BitGroups.h"
+#include "PanelBase.h"
+
+// Maximum number of trigger edges remembered per stream per block.
+#define TTLDEBUG_PATTERN_MAX_TRIGGERS_PER_BLOCK 64
+
+namespace TTLDebugTools
+{
+// One entry in a compiled pattern: at "offset" samples into the period, the pattern lines become "word".
+struct TTLPatternTransition
+{
+    int64 offset;
+    uint64 word;
+};
+
+/**
+
+		Plays user-defined repeating word sequences on groups of TTL lines.
+
+		Each group's sequence is spread evenly over one global period, so groups
+		with different step counts stay synchronised. The sequences are compiled
+		into a flat table of transitions when settings change; process() only
+		walks that table with a cursor.
+
+	*/
+class TTLPatternGenerator : public TTLPanelBase
+{
+public:
+    enum TriggerMode
+    {
+        ManualOneShot = 0,
+        ManualHold,
+        TTLRising,
+        TTLFalling,
+        TTLHigh,
+        TTLLow
+    };
+
+    /** Constructor */
+    TTLPatternGenerator();
+
+    /** Destructor */
+    ~TTLPatternGenerator();
+
+    /** Register parameters */
+    void registerParameters() override;
+
+    /** Create custom editor */
+    AudioProcessorEditor* createEditor() override;
+
+    /** Compiles the pattern for every stream */
+    void updateSettings() override;
+
+    /** Stops any pattern in progress */
+    bool stopAcquisition() override;
+
+    /** Collects trigger edges, then runs the base processing loop */
+    void process (AudioBuffer<float>& buffer) override;
+
+    /** Remembers trigger edges on the selected input line */
+    void handleTTLEvent (TTLEventPtr event) override;
+
+    /** Recompiles the pattern when its definition changes */
+    void parameterValueChanged (Parameter* parameter) override;
+
+    /** Message thread. Manual trigger controls, applied to every stream. */
+    void sendManualCommand (TTLPanelCommand::Type type);
+
+    /** Returns the selected trigger mode */
+    TriggerMode getTriggerMode();
+
+    /** Returns a description of the last compile error, or an empty string */
+    String getLastError() const
+    {
+        return lastError;
+    }
+
+protected:
+    void advanceStream (TTLStreamState& state, int64 sampleNumber) override;
+    void applyCommand (TTLStreamState& state, const TTLPanelCommand& command, int64 sampleNumber) override;
+
+private:
+    struct TriggerEdge
+    {
+        int64 sampleNumber;
+        bool level;
+    };
+
+    struct PatternStreamState
+    {
+        std::vector<TTLPatternTransition> table;
+        int64 periodSamples = 0;
+
+        bool running = false;
+        bool held = false;
+        int64 cycleStart = 0;
+        size_t cursor = 0;
+
+        TriggerEdge triggers[TTLDEBUG_PATTERN_MAX_TRIGGERS_PER_BLOCK];
+        int numTriggers = 0;
+        int nextTrigger = 0;
+    };
+
+    /** Parses the group definitions and rebuilds every stream's transition table */
+    void compilePatterns();
+
+    /** Starts, holds or releases the pattern on one stream */
+    void applyTrigger (TTLStreamState& state, TTLPanelCommand::Type type, int64 sampleNumber);
+
+    /** Converts an input edge into a trigger action, according to the trigger mode */
+    void applyTriggerEdge (TTLStreamState& state, const TriggerEdge& edge);
+
+    std::vector<PatternStreamState> patternStates;
+    uint64 patternMask = 0;
+    TriggerMode triggerMode = ManualOneShot;
+    int triggerLine = 0;
+    String lastError;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TTLPatternGenerator);
+};
+} // namespace TTLDebugTools
+
+#endif
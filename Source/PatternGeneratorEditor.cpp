@@ -0,0 +1,71 @@
+#include "PatternGeneratorEditor.h"
+#include "PatternGenerator.h"
+
+using namespace TTLDebugTools;
+
+// Constructor.
+TTLPatternGeneratorEditor::TTLPatternGeneratorEditor (TTLPatternGenerator* newParent) : GenericEditor (newParent)
+{
+    parent = newParent;
+
+    addTextBoxParameterEditor (Parameter::PROCESSOR_SCOPE, "pattern", 10, 25);
+    addTextBoxParameterEditor (Parameter::PROCESSOR_SCOPE, "period", 10, 75);
+    addComboBoxParameterEditor (Parameter::PROCESSOR_SCOPE, "trigger_mode", 105, 25);
+    addTextBoxParameterEditor (Parameter::PROCESSOR_SCOPE, "trigger_line", 105, 75);
+
+    // Pushbutton in one-shot mode, toggle in hold mode.
+    triggerButton = std::make_unique<UtilityButton> ("Trigger");
+    triggerButton->addListener (this);
+    triggerButton->setRadius (3.0f);
+    triggerButton->setClickingTogglesState (true);
+    triggerButton->setBounds (200, 55, 60, 22);
+    addAndMakeVisible (triggerButton.get());
+
+#if TTLDEBUG_PANEL_INSTRUMENTATION
+    // Writes the hot-path counters to the log, and shows them as a tooltip.
+    perfButton = std::make_unique<UtilityButton> ("Perf");
+    perfButton->addListener (this);
+    perfButton->setRadius (3.0f);
+    perfButton->setBounds (200, 85, 60, 18);
+    addAndMakeVisible (perfButton.get());
+#endif
+
+    setDesiredWidth (270);
+}
+
+// Destructor.
+TTLPatternGeneratorEditor::~TTLPatternGeneratorEditor()
+{
+}
+
+void TTLPatternGeneratorEditor::stopAcquisition()
+{
+    triggerButton->setToggleState (false, dontSendNotification);
+}
+
+void TTLPatternGeneratorEditor::buttonClicked (Button* button)
+{
+#if TTLDEBUG_PANEL_INSTRUMENTATION
+    if (button == perfButton.get())
+    {
+        parent->logInstrumentation();
+        perfButton->setTooltip (parent->getInstrumentationSummary());
+        return;
+    }
+#endif
+
+    if (button != triggerButton.get())
+        return;
+
+    if (parent->getTriggerMode() == TTLPatternGenerator::ManualHold)
+    {
+        parent->sendManualCommand (triggerButton->getToggleState() ? TTLPanelCommand::Hold : TTLPanelCommand::Release);
+    }
+    else
+    {
+        triggerButton->setToggleState (false, dontSendNotification);
+        parent->sendManualCommand (TTLPanelCommand::Trigger);
+    }
+}
+
+// This is the end of the file.
@@ -0,0 +1,38 @@
+#ifndef TTLDEBUGPATTERNGENERATOREDITOR_H_DEFINED
+#define TTLDEBUGPATTERNGENERATOREDITOR_H_DEFINED
+
+#include <EditorHeaders.h>
+
+namespace TTLDebugTools
+{
+class TTLPatternGenerator;
+
+// Pattern definition, trigger settings, and the manual trigger button.
+class TTLPatternGeneratorEditor : public GenericEditor,
+                                  public Button::Listener
+{
+public:
+    /** Constructor */
+    TTLPatternGeneratorEditor (TTLPatternGenerator* newParent);
+
+    /** Destructor */
+    ~TTLPatternGeneratorEditor();
+
+    /** Button callback */
+    void buttonClicked (Button* button);
+
+    /** Called at end of acquisition */
+    void stopAcquisition() override;
+
+private:
+    TTLPatternGenerator* parent;
+    std::unique_ptr<UtilityButton> triggerButton;
+#if TTLDEBUG_PANEL_INSTRUMENTATION
+    std::unique_ptr<UtilityButton> perfButton;
+#endif
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TTLPatternGeneratorEditor);
+};
+} // namespace TTLDebugTools
+
+#endif
@@ -0,0 +1,79 @@
+#ifndef TTLDEBUGSNAPSHOTBUFFER_H_DEFINED
+#define TTLDEBUGSNAPSHOTBUFFER_H_DEFINED
+
+#include <atomic>
+#include <vector>
+
+namespace TTLDebugTools
+{
+/**
+		Wait-free single-producer/single-consumer triple buffer.
+
+		The producer fills its private back buffer and publishes it; the consumer
+		picks up whichever buffer was published most recently. Neither side ever
+		blocks or allocates. resize() must only be called while neither side is active.
+	*/
+template <typename ElementType>
+class TripleBuffer
+{
+public:
+    TripleBuffer() = default;
+
+    // Reallocates all three buffers. Not thread-safe.
+    void resize (size_t numElements)
+    {
+        for (auto& buffer : buffers)
+            buffer.assign (numElements, ElementType());
+
+        backIndex = 0;
+        frontIndex = 1;
+        middleIndex.store (2, std::memory_order_relaxed);
+    }
+
+    size_t size() const
+    {
+        return buffers[0].size();
+    }
+
+    // Producer side. Fill this, then call publish().
+    ElementType* getWriteBuffer()
+    {
+        return buffers[backIndex].data();
+    }
+
+    // Producer side. Returns true if the previous snapshot was never picked up.
+    bool publish()
+    {
+        const int previous = middleIndex.exchange (backIndex | freshFlag, std::memory_order_acq_rel);
+        backIndex = previous & indexMask;
+        return (previous & freshFlag) != 0;
+    }
+
+    // Consumer side. Returns true if a new snapshot is available in getReadBuffer().
+    bool pull()
+    {
+        if ((middleIndex.load (std::memory_order_relaxed) & freshFlag) == 0)
+            return false;
+
+        frontIndex = middleIndex.exchange (frontIndex, std::memory_order_acq_rel) & indexMask;
+        return true;
+    }
+
+    // Consumer side.
+    const ElementType* getReadBuffer() const
+    {
+        return buffers[frontIndex].data();
+    }
+
+private:
+    static constexpr int indexMask = 3;
+    static constexpr int freshFlag = 4;
+
+    std::vector<ElementType> buffers[3];
+    int backIndex = 0;
+    int frontIndex = 1;
+    std::atomic<int> middleIndex { 2 };
+};
+} // namespace TTLDebugTools
+
+#endif
@@ -0,0 +1,324 @@
+#include "StripChartCanvas.h"
+#include "PanelBaseEditor.h"
+
+using namespace TTLDebugTools;
+
+// Private magic constants for canvas geometry.
+
+#define CHART_TOP_YSIZE 40
+#define CHART_LABEL_XSIZE 50
+#define CHART_MARGIN 10
+#define CHART_STREAM_YGAP 16
+#define CHART_MIN_ROW_YSIZE 3
+
+// Constructor.
+TTLStripChartCanvas::TTLStripChartCanvas (TTLPanelBase* processor_) : Visualizer (processor_), processor (processor_)
+{
+    windowSelector = std::make_unique<ComboBox> ("Window");
+    windowSelector->addItem ("1 s", 1);
+    windowSelector->addItem ("10 s", 10);
+    windowSelector->addItem ("60 s", 60);
+    windowSelector->addItem ("300 s", TTLDEBUG_CHART_HISTORY_SECONDS);
+    windowSelector->setSelectedId (windowSeconds, dontSendNotification);
+    windowSelector->addListener (this);
+    addAndMakeVisible (windowSelector.get());
+
+    updateSettings();
+}
+
+// Destructor.
+TTLStripChartCanvas::~TTLStripChartCanvas()
+{
+    processor->setTransitionsWanted (false);
+}
+
+void TTLStripChartCanvas::refreshState()
+{
+    repaint();
+}
+
+// Only called while stopped, so the plugin isn't touching its stream records.
+void TTLStripChartCanvas::updateSettings()
+{
+    const std::vector<TTLStreamState>& states = processor->getStreamStates();
+
+    histories.resize (states.size());
+
+    for (size_t slot = 0; slot < states.size(); slot++)
+    {
+        StreamHistory& history = histories[slot];
+
+        if (auto* stream = processor->getDataStream (states[slot].streamId))
+            history.name = stream->getName();
+
+        history.samplesPerBin = jmax (1.0, double (states[slot].sampleRate) / TTLDEBUG_CHART_BINS_PER_SECOND);
+        history.newestBin = -1;
+    }
+
+    repaint();
+}
+
+void TTLStripChartCanvas::beginAnimation()
+{
+    // Anything left over is from the previous run.
+    TTLTransition transition;
+
+    while (processor->popTransition (transition))
+    {
+    }
+
+    // The history is only allocated once the chart has something to show.
+    for (auto& history : histories)
+    {
+        if (history.bins.empty())
+            history.bins.resize (size_t (TTLDEBUG_CHART_BINS_PER_SECOND) * TTLDEBUG_CHART_HISTORY_SECONDS);
+
+        history.newestBin = -1;
+    }
+
+    droppedTransitions = 0;
+    processor->setTransitionsWanted (true);
+
+    startTimerHz (TTLDEBUG_CHART_REFRESH_HZ);
+}
+
+void TTLStripChartCanvas::endAnimation()
+{
+    processor->setTransitionsWanted (false);
+
+    refresh();
+    stopTimer();
+}
+
+void TTLStripChartCanvas::timerCallback()
+{
+    refresh();
+}
+
+void TTLStripChartCanvas::refresh()
+{
+    TTLTransition transition;
+
+    // Bounded, so a busy plugin can't keep us here forever.
+    for (int count = 0; count < TTLDEBUG_PANEL_TRANSITION_QUEUE_SIZE && processor->popTransition (transition); count++)
+        ingest (transition);
+
+    droppedTransitions = processor->getNumDroppedTransitions();
+
+    repaint();
+}
+
+// Bins between the previous transition and this one hold the previous word; this one's bin gets the edge.
+void TTLStripChartCanvas::ingest (const TTLTransition& transition)
+{
+    if (transition.slot < 0 || transition.slot >= int (histories.size()))
+        return;
+
+    StreamHistory& history = histories[transition.slot];
+    const int64 numBins = int64 (history.bins.size());
+
+    if (numBins == 0)
+        return;
+
+    int64 bin = int64 (double (transition.sampleNumber) / history.samplesPerBin);
+
+    if (history.newestBin < 0)
+    {
+        history.firstBin = bin;
+        history.newestBin = bin;
+        history.word = transition.word;
+        history.bins[size_t (bin % numBins)] = { transition.word, ~transition.word, 0 };
+        return;
+    }
+
+    bin = jmax (bin, history.newestBin);
+
+    for (int64 fill = jmax (history.newestBin + 1, bin - numBins + 1); fill <= bin; fill++)
+        history.bins[size_t (fill % numBins)] = { history.word, ~history.word, 0 };
+
+    TTLChartBin& current = history.bins[size_t (bin % numBins)];
+    current.high |= transition.word;
+    current.low |= ~transition.word;
+    current.edges |= transition.word ^ history.word;
+
+    history.word = transition.word;
+    history.newestBin = bin;
+}
+
+// Each line is drawn as runs of columns in the same state: active, steady high, or steady low.
+void TTLStripChartCanvas::renderStream (Graphics& g, const StreamHistory& history, int top, int rowHeight)
+{
+    const int numColumns = chartImage.getWidth();
+
+    if (history.newestBin < 0 || numColumns <= 0)
+        return;
+
+    const int64 windowBins = int64 (windowSeconds) * TTLDEBUG_CHART_BINS_PER_SECOND;
+    const int64 firstBin = history.newestBin - windowBins + 1;
+    const int64 oldestBin = jmax (history.firstBin, history.newestBin - int64 (history.bins.size()) + 1);
+
+    columnBins.assign (size_t (numColumns), TTLChartBin());
+    columnHasData.assign (size_t (numColumns), false);
+
+    for (int column = 0; column < numColumns; column++)
+    {
+        const int64 endBin = jmax (firstBin + (column * windowBins) / numColumns + 1, firstBin + ((column + 1) * windowBins) / numColumns);
+        const int64 startBin = jmax (oldestBin, firstBin + (column * windowBins) / numColumns);
+
+        if (startBin >= endBin)
+            continue;
+
+        // Merge everything this column covers.
+        TTLChartBin& merged = columnBins[size_t (column)];
+
+        for (int64 bin = startBin; bin < endBin; bin++)
+        {
+            const TTLChartBin& source = history.bins[size_t (bin % int64 (history.bins.size()))];
+            merged.high |= source.high;
+            merged.low |= source.low;
+            merged.edges |= source.edges;
+        }
+
+        columnHasData[size_t (column)] = true;
+    }
+
+    enum RunState
+    {
+        NoData = 0,
+        Active,
+        High,
+        Low
+    };
+
+    for (int line = 0; line < TTLDEBUG_PANEL_TOTAL_BITS; line++)
+    {
+        const uint64 bit = uint64 (1) << line;
+        const int rowTop = top + line * rowHeight + 1;
+        const int rowBottom = top + (line + 1) * rowHeight - 2;
+
+        if (rowBottom >= chartImage.getHeight())
+            break;
+
+        const Colour colour = getTTLLineColour (line);
+        RunState runState = NoData;
+        int runStart = 0;
+
+        // One column past the end closes the last run.
+        for (int column = 0; column <= numColumns; column++)
+        {
+            RunState columnState = NoData;
+
+            if (column < numColumns && columnHasData[size_t (column)])
+            {
+                const TTLChartBin& merged = columnBins[size_t (column)];
+
+                if (((merged.edges | (merged.high & merged.low)) & bit) != 0)
+                    columnState = Active;
+                else if ((merged.high & bit) != 0)
+                    columnState = High;
+                else
+                    columnState = Low;
+            }
+
+            if (column < numColumns && columnState == runState)
+                continue;
+
+            const int runWidth = column - runStart;
+
+            if (runState == Active)
+            {
+                g.setColour (colour);
+                g.fillRect (runStart, rowTop, runWidth, rowBottom - rowTop + 1);
+            }
+            else if (runState == High)
+            {
+                g.setColour (colour);
+                g.fillRect (runStart, rowTop, runWidth, 1);
+            }
+            else if (runState == Low)
+            {
+                g.setColour (colour.withAlpha (0.5f));
+                g.fillRect (runStart, rowBottom, runWidth, 1);
+            }
+
+            runState = columnState;
+            runStart = column;
+        }
+    }
+}
+
+void TTLStripChartCanvas::paint (Graphics& g)
+{
+    g.fillAll (findColour (ThemeColours::componentBackground));
+
+    if (! chartImage.isValid() || histories.empty())
+        return;
+
+    const int numStreams = int (histories.size());
+    const int rowHeight = jmax (CHART_MIN_ROW_YSIZE,
+                                (chartImage.getHeight() - numStreams * CHART_STREAM_YGAP) / (numStreams * TTLDEBUG_PANEL_TOTAL_BITS));
+    const int streamHeight = CHART_STREAM_YGAP + rowHeight * TTLDEBUG_PANEL_TOTAL_BITS;
+
+    chartImage.clear (chartImage.getBounds());
+
+    {
+        Graphics chartGraphics (chartImage);
+
+        for (int slot = 0; slot < numStreams; slot++)
+            renderStream (chartGraphics, histories[slot], slot * streamHeight + CHART_STREAM_YGAP, rowHeight);
+    }
+
+    g.drawImageAt (chartImage, CHART_LABEL_XSIZE, CHART_TOP_YSIZE);
+
+    // Labels. Every line if there's room, otherwise one per bank.
+    g.setColour (findColour (ThemeColours::defaultText));
+
+    for (int slot = 0; slot < numStreams; slot++)
+    {
+        const int top = CHART_TOP_YSIZE + slot * streamHeight;
+
+        g.setFont (12.0f);
+        g.drawText (histories[slot].name, CHART_MARGIN, top, getWidth() - 2 * CHART_MARGIN, CHART_STREAM_YGAP, Justification::left);
+
+        g.setFont (jmin (11.0f, float (rowHeight)));
+
+        for (int line = 0; line < TTLDEBUG_PANEL_TOTAL_BITS; line++)
+        {
+            if (rowHeight < 9 && (line % TTLDEBUG_PANEL_BANK_BITS) != 0)
+                continue;
+
+            g.drawText (String (line + 1), CHART_MARGIN, top + CHART_STREAM_YGAP + line * rowHeight, CHART_LABEL_XSIZE - 2 * CHART_MARGIN, rowHeight, Justification::right);
+        }
+    }
+
+    if (droppedTransitions > 0)
+    {
+        g.setColour (Colours::red);
+        g.setFont (12.0f);
+        g.drawText (String (droppedTransitions) + " transitions dropped", getWidth() - 250, 10, 240, 20, Justification::right);
+    }
+}
+
+void TTLStripChartCanvas::resized()
+{
+    windowSelector->setBounds (CHART_LABEL_XSIZE, 8, 100, 24);
+
+    const int chartWidth = getWidth() - CHART_LABEL_XSIZE - CHART_MARGIN;
+    const int chartHeight = getHeight() - CHART_TOP_YSIZE - CHART_MARGIN;
+
+    if (chartWidth > 0 && chartHeight > 0)
+        chartImage = Image (Image::ARGB, chartWidth, chartHeight, true);
+    else
+        chartImage = Image();
+}
+
+void TTLStripChartCanvas::comboBoxChanged (ComboBox* comboBox)
+{
+    if (comboBox == windowSelector.get())
+    {
+        windowSeconds = jlimit (1, TTLDEBUG_CHART_HISTORY_SECONDS, comboBox->getSelectedId());
+        repaint();
+    }
+}
+
+// This is the end of the file.
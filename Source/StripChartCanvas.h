@@ -0,0 +1,110 @@
+#ifndef TTLDEBUGSTRIPCHARTCANVAS_H_DEFINED
+#define TTLDEBUGSTRIPCHARTCANVAS_H_DEFINED
+
+#include <VisualizerWindowHeaders.h>
+
+#include "PanelBase.h"
+
+// History resolution and length. Memory per stream is 24 bytes per bin, allocated when the chart first scrolls.
+#define TTLDEBUG_CHART_BINS_PER_SECOND 1000
+#define TTLDEBUG_CHART_HISTORY_SECONDS 300
+
+#define TTLDEBUG_CHART_REFRESH_HZ 60
+
+namespace TTLDebugTools
+{
+// Everything the lines did during one bin: which were high, which were low, and which changed.
+// A line that is both high and low, or has an edge, was active within the bin.
+struct TTLChartBin
+{
+    uint64 high = 0;
+    uint64 low = 0;
+    uint64 edges = 0;
+};
+
+/**
+
+		Scrolling strip chart of every TTL line of every stream.
+
+		Transitions from the plugin are folded into fixed-size bins as they
+		arrive, so the history is bounded no matter how busy the lines are.
+		It's only allocated once the chart runs, so a closed tab costs nothing.
+		Each pixel column merges the bins it covers, and each line is drawn as
+		runs of columns that look the same, which keeps drawing cost
+		proportional to the window, not to the event rate.
+
+	*/
+class TTLStripChartCanvas : public Visualizer,
+                            public ComboBox::Listener
+{
+public:
+    /** Constructor */
+    TTLStripChartCanvas (TTLPanelBase* processor);
+
+    /** Destructor */
+    ~TTLStripChartCanvas();
+
+    /** Called when the tab becomes visible again */
+    void refreshState() override;
+
+    /** Picks up the current streams; their history is allocated in beginAnimation() */
+    void updateSettings() override;
+
+    /** Picks up new transitions and redraws */
+    void refresh() override;
+
+    /** Allocates or clears the history and starts scrolling */
+    void beginAnimation() override;
+
+    /** Stops scrolling */
+    void endAnimation() override;
+
+    /** Timer hook. Refreshes the chart. */
+    void timerCallback() override;
+
+    /** Draws the chart */
+    void paint (Graphics& g) override;
+
+    /** Lays out the controls */
+    void resized() override;
+
+    /** Window length selection */
+    void comboBoxChanged (ComboBox* comboBox) override;
+
+private:
+    struct StreamHistory
+    {
+        String name;
+        double samplesPerBin = 1.0;
+
+        // Ring of bins, indexed by bin number modulo its size.
+        std::vector<TTLChartBin> bins;
+
+        // Oldest bin of this run, and newest bin written, or -1 before the first transition.
+        int64 firstBin = 0;
+        int64 newestBin = -1;
+        uint64 word = 0;
+    };
+
+    /** Folds one transition into its stream's bins */
+    void ingest (const TTLTransition& transition);
+
+    /** Draws the traces for one stream into the chart image */
+    void renderStream (Graphics& g, const StreamHistory& history, int top, int rowHeight);
+
+    TTLPanelBase* processor;
+    std::vector<StreamHistory> histories;
+
+    // One merged bin per pixel column, reused from one paint to the next.
+    std::vector<TTLChartBin> columnBins;
+    std::vector<bool> columnHasData;
+    std::unique_ptr<ComboBox> windowSelector;
+    Image chartImage;
+    int windowSeconds = 10;
+    uint32 droppedTransitions = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TTLStripChartCanvas);
+};
+} // namespace TTLDebugTools
+
+#endif
@@ -0,0 +1,505 @@
+#include "TogglePanel.h"
+#include <climits>
+#include <cmath>
+
+using namespace TTLDebugTools;
+
+// Toggle panel (filter).
+
+TTLTogglePanel::TTLTogglePanel() : TTLPanelBase ("TTL Toggle Panel", true)
+{
+    keepsTransitionHistory = true;
+}
+
+TTLTogglePanel::~TTLTogglePanel()
+{
+}
+
+void TTLTogglePanel::registerParameters()
+{
+    TTLPanelBase::registerParameters();
+
+    // Only read by the editor.
+    addStringParameter (Parameter::PROCESSOR_SCOPE,
+                        "word_groups",
+                        "Groups",
+                        "Lines shown and set as one value, lettered A, B, ... in order, e.g. \"1-8; 9-24\"; empty for none",
+                        "",
+                        false);
+
+    // Only read by the editor, when a bit button is clicked.
+    addCategoricalParameter (Parameter::PROCESSOR_SCOPE,
+                             "pulse_mode",
+                             "Click",
+                             "What clicking a bit button does",
+                             { "Toggle", "Pulse +", "Pulse -" },
+                             0,
+                             false);
+
+    addCategoricalParameter (Parameter::PROCESSOR_SCOPE,
+                             "pulse_length",
+                             "Length",
+                             "Pulse length, in milliseconds",
+                             { "1 ms", "3 ms", "10 ms", "30 ms", "100 ms", "300 ms", "1000 ms", "3000 ms" },
+                             4,
+                             false);
+
+    // Replay settings are read when acquisition starts.
+    addPathParameter (Parameter::PROCESSOR_SCOPE,
+                      "replay_file",
+                      "Replay",
+                      "Transition log to play back while acquiring; empty for none",
+                      File(),
+                      { "ttllog" },
+                      false,
+                      true);
+
+    addFloatParameter (Parameter::PROCESSOR_SCOPE,
+                       "replay_rate",
+                       "Rate",
+                       "Playback speed; 2 plays the log twice as fast as it was recorded",
+                       "x",
+                       1.0f,
+                       0.01f,
+                       100.0f,
+                       0.01f,
+                       true);
+
+    addBooleanParameter (Parameter::PROCESSOR_SCOPE,
+                         "replay_loop",
+                         "Loop",
+                         "Start the log again when it ends",
+                         false,
+                         true);
+
+    addFloatParameter (Parameter::PROCESSOR_SCOPE,
+                       "replay_seek",
+                       "Seek",
+                       "Start this far into the log",
+                       "s",
+                       0.0f,
+                       0.0f,
+                       86400.0f,
+                       0.1f,
+                       true);
+
+    // Load generator settings are also read when acquisition starts.
+    addCategoricalParameter (Parameter::PROCESSOR_SCOPE,
+                             "load_mode",
+                             "Load",
+                             "Synthetic traffic: none, evenly spaced edges, or randomly (Poisson) spaced edges",
+                             { "Off", "Periodic", "Poisson" },
+                             0,
+                             true);
+
+    addFloatParameter (Parameter::PROCESSOR_SCOPE,
+                       "load_rate",
+                       "Edges/s",
+                       "Mean edges per second on each generated line",
+                       "Hz",
+                       1000.0f,
+                       0.01f,
+                       1000000.0f,
+                       1.0f,
+                       true);
+
+    addIntParameter (Parameter::PROCESSOR_SCOPE,
+                     "load_lines",
+                     "Lines",
+                     "Number of lines driven, starting at line 1",
+                     8,
+                     1,
+                     TTLDEBUG_PANEL_TOTAL_BITS,
+                     true);
+
+    addIntParameter (Parameter::PROCESSOR_SCOPE,
+                     "load_streams",
+                     "Streams",
+                     "Number of streams driven, starting with the first",
+                     1,
+                     1,
+                     1024,
+                     true);
+
+    addFloatParameter (Parameter::PROCESSOR_SCOPE,
+                       "load_burst",
+                       "Burst",
+                       "Length of each burst of traffic",
+                       "ms",
+                       100.0f,
+                       0.1f,
+                       600000.0f,
+                       0.1f,
+                       true);
+
+    addFloatParameter (Parameter::PROCESSOR_SCOPE,
+                       "load_gap",
+                       "Gap",
+                       "Quiet time between bursts; 0 for continuous traffic",
+                       "ms",
+                       0.0f,
+                       0.0f,
+                       600000.0f,
+                       0.1f,
+                       true);
+
+    addIntParameter (Parameter::PROCESSOR_SCOPE,
+                     "load_seed",
+                     "Seed",
+                     "Random seed; the same seed and settings give the same traffic",
+                     1,
+                     0,
+                     INT_MAX,
+                     true);
+
+    // Barcode settings are read when acquisition starts.
+    addIntParameter (Parameter::PROCESSOR_SCOPE,
+                     "barcode_line",
+                     "Barcode",
+                     "Output line that carries sync barcodes; 0 for none",
+                     0,
+                     0,
+                     TTLDEBUG_PANEL_TOTAL_BITS,
+                     true);
+
+    addIntParameter (Parameter::PROCESSOR_SCOPE,
+                     "barcode_bits",
+                     "Bits",
+                     "Data bits in each barcode",
+                     32,
+                     1,
+                     TTLDEBUG_BARCODE_MAX_BITS,
+                     true);
+
+    addFloatParameter (Parameter::PROCESSOR_SCOPE,
+                       "barcode_bit_ms",
+                       "Bit",
+                       "Length of one barcode bit",
+                       "ms",
+                       20.0f,
+                       0.1f,
+                       1000.0f,
+                       0.1f,
+                       true);
+
+    addFloatParameter (Parameter::PROCESSOR_SCOPE,
+                       "barcode_interval",
+                       "Every",
+                       "Time from the start of one barcode to the start of the next",
+                       "s",
+                       10.0f,
+                       0.01f,
+                       3600.0f,
+                       0.01f,
+                       true);
+
+    // Routing is compiled when acquisition starts.
+    addStringParameter (Parameter::PROCESSOR_SCOPE,
+                        "route_map",
+                        "Route",
+                        "Input lines to output lines, e.g. \"1-4 > 9-12; 5 > !13\"; empty for none",
+                        "",
+                        true);
+
+    addCategoricalParameter (Parameter::PROCESSOR_SCOPE,
+                             "route_logic",
+                             "Logic",
+                             "How several inputs routed to the same output combine",
+                             { "OR", "AND", "XOR" },
+                             0,
+                             true);
+}
+
+void TTLTogglePanel::configureRouter()
+{
+    const String text = getParameter ("route_map")->getValue().toString();
+    const int logic = ((CategoricalParameter*) getParameter ("route_logic"))->getSelectedIndex();
+
+    String error;
+
+    if (! router.parse (text, TTLBitRouter::Logic (logic), error))
+    {
+        LOGE (getName(), ": ", error);
+        CoreServices::sendStatusMessage (getName() + ": " + error);
+    }
+}
+
+void TTLTogglePanel::configureBarcode()
+{
+    barcodeGenerators.clear();
+
+    const int line = int (getParameter ("barcode_line")->getValue());
+
+    if (line <= 0)
+        return;
+
+    const int numBits = int (getParameter ("barcode_bits")->getValue());
+    const double bitMs = double (getParameter ("barcode_bit_ms")->getValue());
+    const double intervalSeconds = double (getParameter ("barcode_interval")->getValue());
+
+    barcodeGenerators.resize (streamStates.size());
+
+    for (auto& state : streamStates)
+    {
+        barcodeGenerators[state.slot].configure (line - 1,
+                                                 numBits,
+                                                 bitMs * 0.001 * state.sampleRate,
+                                                 int64 (std::llround (intervalSeconds * state.sampleRate)));
+    }
+}
+
+void TTLTogglePanel::updateOverlay (TTLStreamState& state, const GeneratedStreamState& generated) const
+{
+    uint64 mask = 0;
+    uint64 bits = 0;
+
+    if (generated.replayStarted)
+    {
+        mask = ~uint64 (0);
+        bits = generated.replayWord;
+    }
+    else if (state.slot < int (loadGenerators.size()) && loadGenerators[state.slot].isRunning())
+    {
+        mask = loadGenerators[state.slot].getLineMask();
+        bits = generated.loadBits;
+    }
+
+    if (state.slot < int (barcodeGenerators.size()))
+    {
+        const uint64 barcodeMask = barcodeGenerators[state.slot].getLineMask();
+
+        mask |= barcodeMask;
+        bits = (bits & ~barcodeMask) | generated.barcodeBits;
+    }
+
+    // Routed outputs win over anything else on the same lines.
+    const uint64 routeMask = router.getOutputMask();
+
+    state.overlayMask = mask | routeMask;
+    state.overlayBits = (bits & ~routeMask) | router.route (generated.inputWord);
+}
+
+void TTLTogglePanel::configureLoad()
+{
+    loadGenerators.clear();
+
+    const int mode = ((CategoricalParameter*) getParameter ("load_mode"))->getSelectedIndex();
+
+    if (mode == 0 || streamStates.empty())
+        return;
+
+    if (replayer != nullptr)
+    {
+        CoreServices::sendStatusMessage (getName() + ": replaying, so the load generator is off");
+        return;
+    }
+
+    const int numLines = jlimit (1, TTLDEBUG_PANEL_TOTAL_BITS, int (getParameter ("load_lines")->getValue()));
+    const int numStreams = jlimit (1, int (streamStates.size()), int (getParameter ("load_streams")->getValue()));
+    const double rate = jmax (0.01, double (getParameter ("load_rate")->getValue()));
+    const double burstMs = double (getParameter ("load_burst")->getValue());
+    const double gapMs = double (getParameter ("load_gap")->getValue());
+    const int64 seed = int64 (getParameter ("load_seed")->getValue());
+
+    loadGenerators.resize (size_t (numStreams));
+
+    for (int slot = 0; slot < numStreams; slot++)
+    {
+        const double sampleRate = streamStates[slot].sampleRate;
+
+        TTLLoadGenerator::Settings settings;
+        settings.timing = mode == 2 ? TTLLoadGenerator::Poisson : TTLLoadGenerator::Periodic;
+        settings.lineMask = numLines == TTLDEBUG_PANEL_TOTAL_BITS ? ~uint64 (0) : (uint64 (1) << numLines) - 1;
+        settings.intervalSamples = sampleRate / rate;
+        settings.burstSamples = jmax (int64 (1), int64 (std::llround (burstMs * 0.001 * sampleRate)));
+        settings.gapSamples = int64 (std::llround (gapMs * 0.001 * sampleRate));
+
+        // Every stream gets its own sequence, but the whole run still depends only on the one seed.
+        loadGenerators[slot].configure (settings, seed, uint64 (slot));
+    }
+
+    LOGC (getName(), ": generating ", rate, " edges/s on ", numLines, " lines of ", numStreams, " streams");
+}
+
+bool TTLTogglePanel::startAcquisition()
+{
+    TTLPanelBase::startAcquisition();
+
+    replayer.reset();
+    generatedStates.assign (streamStates.size(), GeneratedStreamState());
+    droppedInputEdges = 0;
+
+    // Routed outputs start out as if every input were low, and barcode lines idle low; the first block sends them.
+    configureRouter();
+    configureBarcode();
+
+    for (auto& state : streamStates)
+        updateOverlay (state, generatedStates[state.slot]);
+
+    Parameter* fileParam = getParameter ("replay_file");
+    const String path = fileParam != nullptr ? fileParam->getValue().toString().trim() : String();
+
+    if (path.isEmpty() || streamStates.empty())
+    {
+        configureLoad();
+        return true;
+    }
+
+    // Seek and rate are in the log's own time base; the log doesn't store sample rates, so use the output streams'.
+    std::vector<float> sampleRates;
+
+    for (const auto& state : streamStates)
+        sampleRates.push_back (state.sampleRate);
+
+    replayer = std::make_unique<TTLTransitionReplayer>();
+
+    Result started = replayer->start (File (path),
+                                      sampleRates,
+                                      double (getParameter ("replay_seek")->getValue()),
+                                      double (getParameter ("replay_rate")->getValue()),
+                                      bool (getParameter ("replay_loop")->getValue()));
+
+    if (started.failed())
+    {
+        LOGE (getName(), ": replay not started: ", started.getErrorMessage());
+        CoreServices::sendStatusMessage (getName() + ": replay not started");
+        replayer.reset();
+    }
+    else
+    {
+        LOGC (getName(), ": replaying ", path);
+    }
+
+    return true;
+}
+
+bool TTLTogglePanel::stopAcquisition()
+{
+    replayer.reset();
+    loadGenerators.clear();
+    barcodeGenerators.clear();
+
+    if (droppedInputEdges > 0)
+        LOGE (getName(), ": router dropped ", droppedInputEdges, " input edges");
+
+    for (auto& state : streamStates)
+        state.overlayMask = 0;
+
+    return TTLPanelBase::stopAcquisition();
+}
+
+void TTLTogglePanel::process (AudioBuffer<float>& buffer)
+{
+    TTLDEBUG_INSTRUMENT (beginInstrumentedBlock();)
+
+    for (auto& generated : generatedStates)
+    {
+        generated.numEdges = 0;
+        generated.nextEdge = 0;
+    }
+
+    // handleTTLEvent() only records routed edges. The outputs go out in advanceStream(),
+    // in sample order with everything else, so a routed edge leaves at the sample it arrived.
+    if (! router.isEmpty())
+        checkForEvents();
+
+    TTLPanelBase::process (buffer);
+
+    TTLDEBUG_INSTRUMENT (endInstrumentedBlock();)
+}
+
+void TTLTogglePanel::handleTTLEvent (TTLEventPtr event)
+{
+    TTLDEBUG_INSTRUMENT (countReceivedEvent();)
+
+    if (event->getLine() >= TTLDEBUG_PANEL_TOTAL_BITS || ((router.getInputMask() >> event->getLine()) & 1) == 0)
+        return;
+
+    TTLStreamState* state = getStreamState (event->getStreamId());
+
+    if (state == nullptr)
+        return;
+
+    GeneratedStreamState& generated = generatedStates[state->slot];
+
+    if (generated.numEdges < TTLDEBUG_ROUTER_MAX_EDGES_PER_BLOCK)
+        generated.edges[generated.numEdges++] = { event->getSampleNumber(), int (event->getLine()), event->getState() };
+    else
+        droppedInputEdges++;
+}
+
+// Replayed words drive every line; generated load, barcodes and routed inputs drive their own lines.
+// Manual changes still go into the resting word, and pulses still go on top.
+// Everything due at the same sample goes out in one emitWord().
+void TTLTogglePanel::advanceStream (TTLStreamState& state, int64 sampleNumber)
+{
+    GeneratedStreamState& generated = generatedStates[state.slot];
+    TTLLoadGenerator* generator = state.slot < int (loadGenerators.size()) ? &loadGenerators[state.slot] : nullptr;
+    TTLBarcodeGenerator* barcode = state.slot < int (barcodeGenerators.size()) ? &barcodeGenerators[state.slot] : nullptr;
+
+    if (barcode != nullptr && ! barcode->isRunning())
+        barcode->begin (state.blockFirstSample);
+
+    if (replayer != nullptr && generated.replayOrigin < 0)
+        generated.replayOrigin = state.blockFirstSample;
+
+    if (generator != nullptr && ! generator->isRunning())
+    {
+        generator->begin (state.blockFirstSample);
+        updateOverlay (state, generated);
+    }
+
+    while (true)
+    {
+        int64 next = INT64_MAX;
+        const TTLReplayStep* step = replayer != nullptr ? replayer->peek (state.slot) : nullptr;
+
+        if (step != nullptr)
+            next = generated.replayOrigin + step->offset;
+
+        if (generator != nullptr)
+            next = jmin (next, generator->getNextEdgeSample());
+
+        if (barcode != nullptr)
+            next = jmin (next, barcode->getNextEdgeSample());
+
+        if (generated.nextEdge < generated.numEdges)
+            next = jmin (next, generated.edges[generated.nextEdge].sampleNumber);
+
+        if (next >= sampleNumber)
+            break;
+
+        TTLPanelBase::advanceStream (state, next);
+
+        for (; step != nullptr && generated.replayOrigin + step->offset == next; step = replayer->peek (state.slot))
+        {
+            generated.replayWord = step->word;
+            generated.replayStarted = true;
+            replayer->discard (state.slot);
+        }
+
+        if (generator != nullptr && generator->getNextEdgeSample() == next)
+            generated.loadBits ^= generator->takeEdges();
+
+        if (barcode != nullptr && barcode->getNextEdgeSample() == next)
+            generated.barcodeBits = barcode->takeEdge() ? barcode->getLineMask() : 0;
+
+        for (; generated.nextEdge < generated.numEdges && generated.edges[generated.nextEdge].sampleNumber <= next; generated.nextEdge++)
+        {
+            const InputEdge& edge = generated.edges[generated.nextEdge];
+
+            if (edge.level)
+                generated.inputWord |= uint64 (1) << edge.line;
+            else
+                generated.inputWord &= ~(uint64 (1) << edge.line);
+        }
+
+        updateOverlay (state, generated);
+
+        emitWord (state, getBlockOffset (state, next));
+    }
+
+    TTLPanelBase::advanceStream (state, sampleNumber);
+}
+
+// This is the end of the file.
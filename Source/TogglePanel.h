@@ -0,0 +1,108 @@
+#ifndef TTLDEBUGTOGGLEPANEL_H_DEFINED
+#define TTLDEBUGTOGGLEPANEL_H_DEFINED
+
+#include "PanelBase.h"
+#include "BitGroups.h"
+#include "LoadGenerator.h"
+#include "TransitionLog.h"
+
+// Input edges the router can take per stream per block. Any more are dropped, and counted.
+#define TTLDEBUG_ROUTER_MAX_EDGES_PER_BLOCK 1024
+
+namespace TTLDebugTools
+{
+static_assert (TTLDEBUG_PANEL_TOTAL_BITS <= TTLDEBUG_LOAD_MAX_LINES, "The load generator can't drive every line");
+
+/** 
+		Creates an array of buttons to toggle TTL events on and off
+	*/
+class TTLTogglePanel : public TTLPanelBase
+{
+public:
+    /** Constructor */
+    TTLTogglePanel();
+
+    /** Destructor */
+    ~TTLTogglePanel();
+
+    /** Adds the pulse, replay, load generator, barcode and routing controls to the shared parameters */
+    void registerParameters() override;
+
+    /** Compiles the routing, sets up barcodes, and starts replaying the transition file or sets up the load generator if either is enabled */
+    bool startAcquisition() override;
+
+    /** Stops the replay, load, barcodes and routing, and hands the lines back to the resting word */
+    bool stopAcquisition() override;
+
+    /** Collects routed input edges, then runs the base processing loop */
+    void process (AudioBuffer<float>& buffer) override;
+
+    /** Remembers edges on routed input lines */
+    void handleTTLEvent (TTLEventPtr event) override;
+
+protected:
+    /** Emits replayed, generated, barcode and routed transitions that fall before "sampleNumber", at their own samples */
+    void advanceStream (TTLStreamState& state, int64 sampleNumber) override;
+
+private:
+    struct InputEdge
+    {
+        int64 sampleNumber;
+        int line;
+        bool level;
+    };
+
+    // Everything generated on one stream, on top of the resting word.
+    struct GeneratedStreamState
+    {
+        // Replay: the sample offsets count from, or -1 before the first block, and the latest replayed word.
+        int64 replayOrigin = -1;
+        uint64 replayWord = 0;
+        bool replayStarted = false;
+
+        // Load generator lines.
+        uint64 loadBits = 0;
+
+        // Barcode line.
+        uint64 barcodeBits = 0;
+
+        // Router: this block's input edges, in arrival order, and the input word as of the last one applied.
+        InputEdge edges[TTLDEBUG_ROUTER_MAX_EDGES_PER_BLOCK];
+        int numEdges = 0;
+        int nextEdge = 0;
+        uint64 inputWord = 0;
+    };
+
+    /** Sets up the load generator for the first "load_streams" streams, if it's enabled */
+    void configureLoad();
+
+    /** Compiles the routing text */
+    void configureRouter();
+
+    /** Sets up a barcode generator for every stream, if a barcode line is set */
+    void configureBarcode();
+
+    /** Combines replay or load with the routed outputs into the stream's overlay */
+    void updateOverlay (TTLStreamState& state, const GeneratedStreamState& generated) const;
+
+    // Only exists between startAcquisition() and stopAcquisition(), when a file is set.
+    std::unique_ptr<TTLTransitionReplayer> replayer;
+
+    // One per driven stream slot; empty when the load generator is off. Sized in startAcquisition().
+    std::vector<TTLLoadGenerator> loadGenerators;
+
+    // Per stream slot. Sized in startAcquisition().
+    std::vector<GeneratedStreamState> generatedStates;
+
+    // One per stream slot; empty when barcodes are off. Sized in startAcquisition().
+    std::vector<TTLBarcodeGenerator> barcodeGenerators;
+
+    // Only changed while stopped.
+    TTLBitRouter router;
+    uint32 droppedInputEdges = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TTLTogglePanel);
+};
+} // namespace TTLDebugTools
+
+#endif
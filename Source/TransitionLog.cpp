@@ -0,0 +1,481 @@
+#include "TransitionLog.h"
+#include <algorithm>
+#include <cstring>
+
+using namespace TTLDebugTools;
+
+// Returns the file offset of a record.
+static int64 getRecordOffset (uint64 recordIndex)
+{
+    return int64 (sizeof (TTLTransitionLogHeader) + recordIndex * sizeof (TTLTransitionRecord));
+}
+
+// Maps a range of a file, and returns a pointer to its start.
+// MemoryMappedFile rounds the start down to a page boundary, so the data may start a little before what we asked for.
+static void* mapRange (const File& file, int64 start, int64 length, std::unique_ptr<MemoryMappedFile>& mapping)
+{
+    mapping = std::make_unique<MemoryMappedFile> (file, Range<int64> (start, start + length), MemoryMappedFile::readWrite);
+
+    if (mapping->getData() == nullptr || mapping->getRange().getEnd() < start + length)
+    {
+        mapping.reset();
+        return nullptr;
+    }
+
+    return static_cast<char*> (mapping->getData()) + (start - mapping->getRange().getStart());
+}
+
+//
+// Index.
+
+void TTLTransitionIndexBuilder::clear()
+{
+    streams.clear();
+    checkpoints.clear();
+}
+
+void TTLTransitionIndexBuilder::add (uint64 recordIndex, const TTLTransitionRecord& record)
+{
+    StreamProgress& stream = streams[record.streamId];
+    const TTLTransitionCheckpoint checkpoint = { recordIndex, record.sampleNumber, record.streamId, {} };
+
+    if (stream.numRecords % TTLDEBUG_LOG_CHECKPOINT_INTERVAL == 0)
+        checkpoints.push_back (checkpoint);
+
+    stream.numRecords++;
+    stream.last = checkpoint;
+}
+
+std::vector<TTLTransitionCheckpoint> TTLTransitionIndexBuilder::finish()
+{
+    std::vector<TTLTransitionCheckpoint> sorted = checkpoints;
+
+    // The last record closes the final interval, unless it's a checkpoint already.
+    for (auto& entry : streams)
+    {
+        if ((entry.second.numRecords - 1) % TTLDEBUG_LOG_CHECKPOINT_INTERVAL != 0)
+            sorted.push_back (entry.second.last);
+    }
+
+    std::sort (sorted.begin(), sorted.end(), [] (const TTLTransitionCheckpoint& a, const TTLTransitionCheckpoint& b)
+               { return a.streamId != b.streamId ? a.streamId < b.streamId : a.recordIndex < b.recordIndex; });
+
+    return sorted;
+}
+
+//
+// Writer.
+
+// Constructor.
+TTLTransitionLogWriter::TTLTransitionLogWriter (const File& file_) : Thread ("TTL transition log"), file (file_)
+{
+}
+
+// Destructor.
+TTLTransitionLogWriter::~TTLTransitionLogWriter()
+{
+    close();
+}
+
+Result TTLTransitionLogWriter::open()
+{
+    queue.resize (TTLDEBUG_LOG_QUEUE_SIZE);
+    index.clear();
+    numRecords = 0;
+    numDropped.store (0, std::memory_order_relaxed);
+    failed = false;
+
+    Result created = file.create();
+
+    if (created.failed())
+        return created;
+
+    // The header goes in first, so the file is valid (if empty) from here on.
+    {
+        FileOutputStream stream (file);
+
+        if (! stream.openedOk())
+            return Result::fail ("can't write " + file.getFullPathName());
+
+        stream.setPosition (0);
+        stream.truncate();
+
+        TTLTransitionLogHeader header = {};
+        std::memcpy (header.magic, TTLDEBUG_LOG_MAGIC, sizeof (header.magic));
+        header.version = TTLDEBUG_LOG_VERSION;
+        header.recordSize = sizeof (TTLTransitionRecord);
+        header.checkpointInterval = TTLDEBUG_LOG_CHECKPOINT_INTERVAL;
+
+        stream.write (&header, sizeof (header));
+    }
+
+    if (mapRange (file, 0, sizeof (TTLTransitionLogHeader), headerMapping) == nullptr || ! mapChunk (0))
+    {
+        headerMapping.reset();
+        return Result::fail ("can't map " + file.getFullPathName());
+    }
+
+    isOpen = true;
+    startThread();
+
+    return Result::ok();
+}
+
+void TTLTransitionLogWriter::close()
+{
+    if (! isOpen)
+        return;
+
+    stopThread (1000);
+
+    // Whatever arrived after the thread's last pass.
+    drain();
+
+    chunkMapping.reset();
+    chunkRecords = nullptr;
+
+    // Nothing may be mapped while the file is truncated; Windows refuses to truncate a mapped file.
+    TTLTransitionLogHeader header = {};
+
+    if (const TTLTransitionLogHeader* mapped = getHeader())
+        header = *mapped;
+
+    headerMapping.reset();
+
+    const int64 indexOffset = getRecordOffset (numRecords);
+    const std::vector<TTLTransitionCheckpoint> checkpoints = index.finish();
+
+    header.numRecords = numRecords;
+    header.indexOffset = uint64 (indexOffset);
+    header.numCheckpoints = checkpoints.size();
+
+    // Drop the unused tail of the last chunk, append the index, then finish the header.
+    {
+        FileOutputStream stream (file);
+
+        if (stream.openedOk())
+        {
+            stream.setPosition (indexOffset);
+            stream.truncate();
+            stream.write (checkpoints.data(), checkpoints.size() * sizeof (TTLTransitionCheckpoint));
+            stream.setPosition (0);
+            stream.write (&header, sizeof (header));
+            stream.flush();
+        }
+        else
+        {
+            LOGE ("TTL transition log: can't finish ", file.getFullPathName());
+        }
+    }
+
+    isOpen = false;
+
+    if (numDropped.load (std::memory_order_relaxed) > 0)
+        LOGE ("TTL transition log dropped ", numDropped.load (std::memory_order_relaxed), " records");
+}
+
+bool TTLTransitionLogWriter::push (const TTLTransitionRecord& record)
+{
+    if (queue.push (record))
+        return true;
+
+    numDropped.store (numDropped.load (std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    return false;
+}
+
+TTLTransitionLogHeader* TTLTransitionLogWriter::getHeader() const
+{
+    if (headerMapping == nullptr)
+        return nullptr;
+
+    return reinterpret_cast<TTLTransitionLogHeader*> (static_cast<char*> (headerMapping->getData()) - headerMapping->getRange().getStart());
+}
+
+bool TTLTransitionLogWriter::mapChunk (uint64 recordIndex)
+{
+    chunkMapping.reset();
+    chunkRecords = nullptr;
+
+    chunkFirstRecord = recordIndex - (recordIndex % TTLDEBUG_LOG_CHUNK_RECORDS);
+
+    const int64 chunkStart = getRecordOffset (chunkFirstRecord);
+    const int64 chunkLength = int64 (TTLDEBUG_LOG_CHUNK_RECORDS) * int64 (sizeof (TTLTransitionRecord));
+
+    // Grow the file to cover the whole chunk. The gap is sparse on most filesystems.
+    if (file.getSize() < chunkStart + chunkLength)
+    {
+        FileOutputStream stream (file);
+
+        if (! stream.openedOk())
+            return false;
+
+        stream.setPosition (chunkStart + chunkLength - 1);
+        stream.writeByte (0);
+        stream.flush();
+    }
+
+    chunkRecords = static_cast<TTLTransitionRecord*> (mapRange (file, chunkStart, chunkLength, chunkMapping));
+
+    return chunkRecords != nullptr;
+}
+
+void TTLTransitionLogWriter::drain()
+{
+    TTLTransitionRecord record;
+
+    while (! failed && queue.pop (record))
+    {
+        if (numRecords >= chunkFirstRecord + TTLDEBUG_LOG_CHUNK_RECORDS || chunkRecords == nullptr)
+        {
+            if (! mapChunk (numRecords))
+            {
+                LOGE ("TTL transition log: can't grow ", file.getFullPathName());
+                failed = true;
+                break;
+            }
+        }
+
+        index.add (numRecords, record);
+
+        chunkRecords[numRecords - chunkFirstRecord] = record;
+        numRecords++;
+    }
+
+    // Readers of a log that's still being written can trust everything up to here.
+    if (TTLTransitionLogHeader* header = getHeader())
+        header->numRecords = numRecords;
+}
+
+void TTLTransitionLogWriter::run()
+{
+    while (! threadShouldExit())
+    {
+        wait (TTLDEBUG_LOG_FLUSH_MS);
+        drain();
+    }
+}
+
+//
+// Reader.
+
+// Constructor.
+TTLTransitionLogReader::TTLTransitionLogReader()
+{
+}
+
+// Destructor.
+TTLTransitionLogReader::~TTLTransitionLogReader()
+{
+}
+
+Result TTLTransitionLogReader::open (const File& file)
+{
+    mapping = std::make_unique<MemoryMappedFile> (file, MemoryMappedFile::readOnly);
+    records = nullptr;
+    checkpoints = nullptr;
+    numRecords = 0;
+    numCheckpoints = 0;
+    builtIndex.clear();
+    streams.clear();
+
+    const char* data = static_cast<const char*> (mapping->getData());
+    const uint64 size = mapping->getSize();
+
+    if (data == nullptr || size < sizeof (TTLTransitionLogHeader))
+        return Result::fail ("can't read " + file.getFullPathName());
+
+    const TTLTransitionLogHeader* header = reinterpret_cast<const TTLTransitionLogHeader*> (data);
+
+    if (std::memcmp (header->magic, TTLDEBUG_LOG_MAGIC, sizeof (header->magic)) != 0
+        || header->version != TTLDEBUG_LOG_VERSION
+        || header->recordSize != sizeof (TTLTransitionRecord))
+        return Result::fail (file.getFileName() + " isn't a transition log");
+
+    // A log that was never closed has no index, and may have unused space after the records.
+    numRecords = jmin (header->numRecords, (size - sizeof (TTLTransitionLogHeader)) / sizeof (TTLTransitionRecord));
+    records = reinterpret_cast<const TTLTransitionRecord*> (data + sizeof (TTLTransitionLogHeader));
+
+    if (header->indexOffset != 0 && header->indexOffset + header->numCheckpoints * sizeof (TTLTransitionCheckpoint) <= size)
+    {
+        checkpoints = reinterpret_cast<const TTLTransitionCheckpoint*> (data + header->indexOffset);
+        numCheckpoints = header->numCheckpoints;
+    }
+    else
+    {
+        // Never closed: index what made it to disk.
+        TTLTransitionIndexBuilder builder;
+
+        for (uint64 record = 0; record < numRecords; record++)
+            builder.add (record, records[record]);
+
+        builtIndex = builder.finish();
+        checkpoints = builtIndex.data();
+        numCheckpoints = builtIndex.size();
+    }
+
+    for (uint64 checkpoint = 0; checkpoint < numCheckpoints; checkpoint++)
+    {
+        if (streams.empty() || streams.back().streamId != checkpoints[checkpoint].streamId)
+            streams.push_back ({ checkpoints[checkpoint].streamId, checkpoint, checkpoint });
+
+        streams.back().endCheckpoint = checkpoint + 1;
+    }
+
+    std::sort (streams.begin(), streams.end(), [this] (const StreamCheckpoints& a, const StreamCheckpoints& b)
+               { return checkpoints[a.firstCheckpoint].recordIndex < checkpoints[b.firstCheckpoint].recordIndex; });
+
+    return Result::ok();
+}
+
+uint64 TTLTransitionLogReader::findRecord (int stream, int64 sampleNumber) const
+{
+    const TTLTransitionCheckpoint* first = checkpoints + streams[stream].firstCheckpoint;
+    const TTLTransitionCheckpoint* end = checkpoints + streams[stream].endCheckpoint;
+
+    // The stream's last record is a checkpoint, so running off the end means there's nothing at or after the sample.
+    const TTLTransitionCheckpoint* at = std::lower_bound (first, end, sampleNumber, [] (const TTLTransitionCheckpoint& checkpoint, int64 value)
+                                                          { return checkpoint.sampleNumber < value; });
+
+    if (at == end)
+        return numRecords;
+
+    if (at == first)
+        return first->recordIndex;
+
+    // Other streams' records are interleaved with this one's, so the interval is scanned rather than bisected.
+    const uint16 streamId = streams[stream].streamId;
+
+    for (uint64 record = (at - 1)->recordIndex + 1; record < at->recordIndex; record++)
+    {
+        if (records[record].streamId == streamId && records[record].sampleNumber >= sampleNumber)
+            return record;
+    }
+
+    return at->recordIndex;
+}
+
+//
+// Replayer.
+
+// Constructor.
+TTLTransitionReplayer::TTLTransitionReplayer() : Thread ("TTL transition replay")
+{
+}
+
+// Destructor.
+TTLTransitionReplayer::~TTLTransitionReplayer()
+{
+    stop();
+}
+
+Result TTLTransitionReplayer::start (const File& file, const std::vector<float>& sampleRates, double startSeconds, double rate_, bool loop_)
+{
+    stop();
+
+    Result opened = reader.open (file);
+
+    if (opened.failed())
+        return opened;
+
+    if (reader.getNumRecords() == 0)
+        return Result::fail (file.getFileName() + " has no transitions");
+
+    queues.clear();
+    cursors.clear();
+
+    for (size_t slot = 0; slot < sampleRates.size(); slot++)
+    {
+        queues.push_back (std::make_unique<LockFreeFifo<TTLReplayStep>>());
+        queues.back()->resize (TTLDEBUG_REPLAY_QUEUE_SIZE);
+    }
+
+    rate = jmax (0.001, rate_);
+    loop = loop_;
+
+    bool anyStarted = false;
+
+    for (int slot = 0; slot < jmin (int (sampleRates.size()), reader.getNumStreams()); slot++)
+    {
+        StreamCursor cursor;
+        cursor.streamId = reader.getStreamId (slot);
+        cursor.lastRecord = reader.getLastRecord (slot);
+
+        // Offsets count from the seek point, so each stream keeps its timing relative to it.
+        const int64 streamStart = reader.getRecord (reader.getFirstRecord (slot)).sampleNumber;
+        cursor.seekSample = streamStart + int64 (startSeconds * sampleRates[slot]);
+        cursor.firstRecord = reader.findRecord (slot, cursor.seekSample);
+
+        if (cursor.firstRecord < reader.getNumRecords())
+        {
+            cursor.cursor = cursor.firstRecord;
+            cursor.loopLength = int64 (double (reader.getRecord (cursor.lastRecord).sampleNumber - cursor.seekSample) / rate) + 1;
+            cursor.finished = false;
+            anyStarted = true;
+        }
+
+        cursors.push_back (cursor);
+    }
+
+    if (! anyStarted)
+        return Result::fail ("start point is past the end of " + file.getFileName());
+
+    // Fill the queues before the first block asks for anything.
+    for (int slot = 0; slot < int (cursors.size()); slot++)
+        prefetch (slot);
+
+    startThread();
+
+    return Result::ok();
+}
+
+void TTLTransitionReplayer::stop()
+{
+    stopThread (1000);
+}
+
+void TTLTransitionReplayer::prefetch (int slot)
+{
+    StreamCursor& stream = cursors[slot];
+
+    while (! stream.finished)
+    {
+        const TTLTransitionRecord& record = reader.getRecord (stream.cursor);
+
+        if (record.streamId == stream.streamId)
+        {
+            TTLReplayStep step;
+            step.offset = stream.loopBase + int64 (double (record.sampleNumber - stream.seekSample) / rate);
+            step.word = record.word;
+
+            // Full; try again next time round.
+            if (! queues[slot]->push (step))
+                return;
+        }
+
+        if (stream.cursor++ < stream.lastRecord)
+            continue;
+
+        if (loop)
+        {
+            stream.cursor = stream.firstRecord;
+            stream.loopBase += stream.loopLength;
+        }
+        else
+        {
+            stream.finished = true;
+        }
+    }
+}
+
+void TTLTransitionReplayer::run()
+{
+    while (! threadShouldExit())
+    {
+        for (int slot = 0; slot < int (cursors.size()); slot++)
+            prefetch (slot);
+
+        wait (TTLDEBUG_REPLAY_PREFETCH_MS);
+    }
+}
+
+// This is the end of the file.
@@ -0,0 +1,317 @@
+#ifndef TTLDEBUGTRANSITIONLOG_H_DEFINED
+#define TTLDEBUGTRANSITIONLOG_H_DEFINED
+
+#include <ProcessorHeaders.h>
+
+#include "LockFreeFifo.h"
+
+// Records that can be waiting for the writer thread.
+#define TTLDEBUG_LOG_QUEUE_SIZE 262144
+
+// Records mapped at a time. The file grows by this much whenever the mapping fills up.
+#define TTLDEBUG_LOG_CHUNK_RECORDS 1048576
+
+// Records between two index checkpoints.
+#define TTLDEBUG_LOG_CHECKPOINT_INTERVAL 4096
+
+// How often the writer thread wakes up to flush the queue.
+#define TTLDEBUG_LOG_FLUSH_MS 20
+
+// Replay steps prefetched per stream, and how often the replay thread tops them up.
+#define TTLDEBUG_REPLAY_QUEUE_SIZE 16384
+#define TTLDEBUG_REPLAY_PREFETCH_MS 5
+
+namespace TTLDebugTools
+{
+// On-disk layout, in the writer's native (little-endian) byte order:
+//   TTLTransitionLogHeader
+//   numRecords x TTLTransitionRecord
+//   numCheckpoints x TTLTransitionCheckpoint, at indexOffset
+// numRecords is kept current while the log is written; the index is only added when the log is closed.
+struct TTLTransitionLogHeader
+{
+    char magic[8];
+    uint32 version;
+    uint32 recordSize;
+    uint64 numRecords;
+    uint64 indexOffset;
+    uint64 numCheckpoints;
+    uint64 checkpointInterval;
+    uint8 reserved[16];
+};
+
+// From "sampleNumber" on, stream "streamId" carries "word".
+// Records of different streams are interleaved in arrival order, and each stream counts samples on its own clock,
+// so sample numbers only go up within one stream.
+struct TTLTransitionRecord
+{
+    int64 sampleNumber;
+    uint64 word;
+    uint16 streamId;
+    uint16 reserved[3];
+};
+
+// A stream's first record, every checkpointInterval-th record after it, and its last record, so a reader can seek
+// within one stream without scanning the whole log. The index is sorted by stream ID, then record index.
+struct TTLTransitionCheckpoint
+{
+    uint64 recordIndex;
+    int64 sampleNumber;
+    uint16 streamId;
+    uint16 reserved[3];
+};
+
+static_assert (sizeof (TTLTransitionLogHeader) == 64, "Transition log header layout changed");
+static_assert (sizeof (TTLTransitionRecord) == 24, "Transition log record layout changed");
+static_assert (sizeof (TTLTransitionCheckpoint) == 24, "Transition log checkpoint layout changed");
+
+#define TTLDEBUG_LOG_MAGIC "TTLTLOG1"
+#define TTLDEBUG_LOG_VERSION 2
+
+// Builds the checkpoint index from records in log order. Used by the writer, and by the reader for logs that were never closed.
+class TTLTransitionIndexBuilder
+{
+public:
+    void clear();
+
+    void add (uint64 recordIndex, const TTLTransitionRecord& record);
+
+    // Adds each stream's last record and sorts the index into its on-disk order.
+    std::vector<TTLTransitionCheckpoint> finish();
+
+private:
+    struct StreamProgress
+    {
+        uint64 numRecords = 0;
+        TTLTransitionCheckpoint last = {};
+    };
+
+    std::map<uint16, StreamProgress> streams;
+    std::vector<TTLTransitionCheckpoint> checkpoints;
+};
+
+/**
+
+		Append-only binary log of TTL transitions.
+
+		The audio thread pushes records into a lock-free queue. A background
+		thread copies them into a memory-mapped window of the file, growing the
+		file a chunk at a time, so the disk only ever sees large sequential writes.
+
+	*/
+class TTLTransitionLogWriter : public Thread
+{
+public:
+    /** Constructor */
+    TTLTransitionLogWriter (const File& file);
+
+    /** Destructor. Closes the log if it's still open. */
+    ~TTLTransitionLogWriter();
+
+    /** Message thread. Creates the file and starts the writer thread. */
+    Result open();
+
+    /** Message thread. Flushes everything, writes the index and stops the writer thread. */
+    void close();
+
+    /** Audio thread. Returns false, and counts a drop, if the writer has fallen behind. */
+    bool push (const TTLTransitionRecord& record);
+
+    /** Records lost because the queue was full */
+    uint64 getNumDropped() const
+    {
+        return numDropped.load (std::memory_order_relaxed);
+    }
+
+    const File& getFile() const
+    {
+        return file;
+    }
+
+    /** Writer thread */
+    void run() override;
+
+private:
+    /** Copies everything queued into the file */
+    void drain();
+
+    /** Grows the file if needed, and maps the chunk holding "recordIndex" */
+    bool mapChunk (uint64 recordIndex);
+
+    TTLTransitionLogHeader* getHeader() const;
+
+    File file;
+    LockFreeFifo<TTLTransitionRecord> queue;
+
+    std::unique_ptr<MemoryMappedFile> headerMapping;
+    std::unique_ptr<MemoryMappedFile> chunkMapping;
+    TTLTransitionRecord* chunkRecords = nullptr;
+    uint64 chunkFirstRecord = 0;
+
+    uint64 numRecords = 0;
+    TTLTransitionIndexBuilder index;
+    std::atomic<uint64> numDropped { 0 };
+    bool failed = false;
+    bool isOpen = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TTLTransitionLogWriter);
+};
+
+/**
+
+		Read-only view of a transition log, mapped in whole.
+
+	*/
+class TTLTransitionLogReader
+{
+public:
+    /** Constructor */
+    TTLTransitionLogReader();
+
+    /** Destructor */
+    ~TTLTransitionLogReader();
+
+    /** Maps a log and checks its header */
+    Result open (const File& file);
+
+    uint64 getNumRecords() const
+    {
+        return numRecords;
+    }
+
+    const TTLTransitionRecord& getRecord (uint64 index) const
+    {
+        return records[index];
+    }
+
+    /** Recorded streams, in the order they first appear in the log */
+    int getNumStreams() const
+    {
+        return int (streams.size());
+    }
+
+    uint16 getStreamId (int stream) const
+    {
+        return streams[stream].streamId;
+    }
+
+    /** Index of a stream's first and last records */
+    uint64 getFirstRecord (int stream) const
+    {
+        return checkpoints[streams[stream].firstCheckpoint].recordIndex;
+    }
+
+    uint64 getLastRecord (int stream) const
+    {
+        return checkpoints[streams[stream].endCheckpoint - 1].recordIndex;
+    }
+
+    /** Returns the stream's first record at or after "sampleNumber", or getNumRecords() if there is none.
+        Narrows the search with the stream's checkpoints, then scans the records between two of them. */
+    uint64 findRecord (int stream, int64 sampleNumber) const;
+
+private:
+    // One stream's run of the (sorted) index.
+    struct StreamCheckpoints
+    {
+        uint16 streamId;
+        uint64 firstCheckpoint;
+        uint64 endCheckpoint;
+    };
+
+    std::unique_ptr<MemoryMappedFile> mapping;
+    const TTLTransitionRecord* records = nullptr;
+    const TTLTransitionCheckpoint* checkpoints = nullptr;
+    uint64 numRecords = 0;
+    uint64 numCheckpoints = 0;
+
+    // Only used for a log that was never closed, and so has no index of its own.
+    std::vector<TTLTransitionCheckpoint> builtIndex;
+
+    std::vector<StreamCheckpoints> streams;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TTLTransitionLogReader);
+};
+
+// One step of a replay: "offset" samples after replay started, the stream's output becomes "word".
+struct TTLReplayStep
+{
+    int64 offset;
+    uint64 word;
+};
+
+/**
+
+		Streams a transition log back, for a source panel to emit.
+
+		A background thread walks the mapped log and keeps a queue per output
+		stream topped up, so the audio thread only ever pops from memory that's
+		already been read. Recorded streams are assigned to output streams in
+		the order they first appear in the log.
+
+	*/
+class TTLTransitionReplayer : public Thread
+{
+public:
+    /** Constructor */
+    TTLTransitionReplayer();
+
+    /** Destructor */
+    ~TTLTransitionReplayer();
+
+    /** Message thread. Opens a log and starts prefetching from "startSeconds" into each recorded stream.
+        There's one output stream per entry in "sampleRates"; seek times are converted with the rate of the
+        output stream a recorded stream plays on, since the log doesn't store one.
+        Offsets are scaled by 1 / "rate"; with "loop", each stream restarts from its seek point when it ends. */
+    Result start (const File& file, const std::vector<float>& sampleRates, double startSeconds, double rate, bool loop);
+
+    /** Message thread. Stops prefetching. */
+    void stop();
+
+    /** Audio thread. Returns the next step for an output stream, or nullptr if none is ready. */
+    const TTLReplayStep* peek (int slot) const
+    {
+        return queues[slot]->peek();
+    }
+
+    /** Audio thread. Removes the step returned by peek(). */
+    void discard (int slot)
+    {
+        queues[slot]->discard();
+    }
+
+    /** Replay thread */
+    void run() override;
+
+private:
+    // Where one recorded stream is up to. Each stream keeps its own sample base, seek point and loop length,
+    // since recorded streams needn't share a clock.
+    struct StreamCursor
+    {
+        uint16 streamId = 0;
+        uint64 firstRecord = 0;
+        uint64 lastRecord = 0;
+        uint64 cursor = 0;
+        int64 seekSample = 0;
+        int64 loopLength = 0;
+        int64 loopBase = 0;
+        bool finished = true;
+    };
+
+    /** Pushes one stream's records until its queue fills up or the stream ends */
+    void prefetch (int slot);
+
+    TTLTransitionLogReader reader;
+    std::vector<std::unique_ptr<LockFreeFifo<TTLReplayStep>>> queues;
+
+    // One per output slot. Recorded streams beyond the number of outputs aren't played.
+    std::vector<StreamCursor> cursors;
+
+    double rate = 1.0;
+    bool loop = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TTLTransitionReplayer);
+};
+} // namespace TTLDebugTools
+
+#endif